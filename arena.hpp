@@ -0,0 +1,127 @@
+#ifndef ARENA_HPP_DEFINED
+#define ARENA_HPP_DEFINED
+
+/**
+ * \file arena.hpp
+ * \brief Header file containing the declaration of the arena_scope type, used to allocate short-lived objects together.
+ */
+
+#include <memory_resource>
+#include <cstddef>
+
+namespace univ_nantes {
+
+  /**
+   * \class arena_scope arena.hpp
+   * \brief Makes a monotonic arena the default memory resource, for the lifetime of the object
+   *
+   * Sets and automata, including their names, take their memory from the default memory resource (see set.hpp).
+   * While an arena_scope is alive, they are allocated in a monotonic buffer: allocations are a pointer bump,
+   * deallocations do nothing, and all the memory is given back at once when the arena_scope is destroyed, or
+   * released with release(). Since nothing is freed before, an arena must only hold the temporaries of one
+   * bounded computation, such as one determinization or one parsed automaton.
+   *
+   * Objects built in the arena must be destroyed before the arena_scope. A result that must outlive it is copied
+   * out with copy_out(), which first restores the previous default resource:
+   *
+   *   automaton f() {
+   *     arena_scope arena;
+   *     automaton a = ...;        // a and all temporaries are allocated in the arena
+   *     return arena.copy_out(a); // the returned copy is allocated from the previous resource
+   *   }
+   *
+   * Arena scopes can be nested: each arena takes its blocks from the global heap, so that releasing an inner arena
+   * gives its memory back at once. The default memory resource is global, and an arena is not thread-safe: code
+   * that runs on several threads must be wrapped in a shared_heap_scope.
+   */
+  class arena_scope {
+  private:
+    std::pmr::memory_resource* previous;       /*!< Default resource when the scope was entered. */
+    std::pmr::monotonic_buffer_resource arena; /*!< Arena, which takes its blocks from the global heap. */
+    bool active;                               /*!< true while the arena is the default resource. */
+
+  public:
+    static const std::size_t initial_size = 64 * 1024; /*!< Size of the first block of the arena, in bytes. */
+
+    /**
+     * \fn arena_scope()
+     * \brief Creates an empty arena, and makes it the default memory resource
+     */
+    arena_scope() : previous(std::pmr::get_default_resource()), arena(initial_size, std::pmr::new_delete_resource()), active(true) {
+      std::pmr::set_default_resource(&arena);
+    }
+
+    arena_scope(const arena_scope&) = delete;
+    arena_scope& operator=(const arena_scope&) = delete;
+
+    /**
+     * \fn ~arena_scope()
+     * \brief Restores the previous default memory resource, and releases all the memory of the arena
+     */
+    ~arena_scope() { leave(); }
+
+    /**
+     * \fn void leave()
+     * \brief Restores the previous default memory resource; the arena keeps its memory until it is destroyed
+     */
+    void leave() {
+      if(active) std::pmr::set_default_resource(previous);
+      active = false;
+    }
+
+    /**
+     * \fn void release()
+     * \brief Releases all the memory of the arena, and makes it the default memory resource again
+     *
+     * No object allocated in the arena may still be alive. This allows a single scope to run a series of
+     * computations, each one starting from an empty arena.
+     */
+    void release() {
+      arena.release();
+      std::pmr::set_default_resource(&arena);
+      active = true;
+    }
+
+    /**
+     * \fn T copy_out(const T& value)
+     * \brief Leaves the arena, and returns a copy of value allocated from the previous default memory resource
+     */
+    template<typename T>
+    T copy_out(const T& value) {
+      leave();
+      return T(value);
+    }
+  };
+
+  /**
+   * \class shared_heap_scope arena.hpp
+   * \brief Makes the global heap the default memory resource, for the lifetime of the object
+   *
+   * The global heap, std::pmr::new_delete_resource(), can be used by several threads at once. The threads started
+   * inside an arena_scope, such as those of parallel_for, must run inside a shared_heap_scope: the objects they
+   * build are then allocated from the heap, and the arena is restored when the scope ends.
+   */
+  class shared_heap_scope {
+  private:
+    std::pmr::memory_resource* previous; /*!< Default resource when the scope was entered. */
+
+  public:
+    /**
+     * \fn shared_heap_scope()
+     * \brief Makes the global heap the default memory resource
+     */
+    shared_heap_scope() : previous(std::pmr::set_default_resource(std::pmr::new_delete_resource())) {}
+
+    shared_heap_scope(const shared_heap_scope&) = delete;
+    shared_heap_scope& operator=(const shared_heap_scope&) = delete;
+
+    /**
+     * \fn ~shared_heap_scope()
+     * \brief Restores the previous default memory resource
+     */
+    ~shared_heap_scope() { std::pmr::set_default_resource(previous); }
+  };
+
+}
+
+#endif // ARENA_HPP_DEFINED
@@ -8,109 +8,357 @@
 
 #include "automaton.hpp"
 #include "set.hpp"
+#include "bitset.hpp"
+#include "subset_pool.hpp"
+#include "transition_index.hpp"
+#include "closure_table.hpp"
+#include "arena.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <climits>
+#include <vector>
 
 using namespace univ_nantes;
 
+namespace {
+
+  /**
+   * \fn std::size_t dense_state_count(const automaton& a)
+   * \brief Gets the number of rows of a transition_index of a: its greatest state plus one, if its states are dense
+   * \return 0 if some state is negative, or so large that arrays indexed by the states would not be in proportion to
+   *         the size of a: its states must then be renumbered first, see automaton::compact()
+   */
+  std::size_t dense_state_count(const automaton& a) {
+    std::size_t limit = 2 * (2 * a.transitions.size() + a.initials.size() + a.finals.size()) + 64;
+    int greatest = -1;
+    auto dense = [&](int q) { greatest = std::max(greatest, q); return q >= 0 && (std::size_t)q < limit; };
+    for(int q : a.initials) if(!dense(q)) return 0;
+    for(int q : a.finals) if(!dense(q)) return 0;
+    for(const transition& t : a.transitions) if(!dense(t.start) || !dense(t.end)) return 0;
+    return greatest + 1;
+  }
+
+  /**
+   * \fn automaton renumbered(const automaton& a, const std::vector<int>& old_state)
+   * \brief Gets a copy of a in which each state q is numbered old_state[q], to undo automaton::compact()
+   */
+  automaton renumbered(const automaton& a, const std::vector<int>& old_state) {
+    automaton result;
+    result.name = a.name;
+    set<int>::builder initials, finals;
+    for(int q : a.initials) initials.add(old_state[q]);
+    for(int q : a.finals) finals.add(old_state[q]);
+    set<transition>::builder transitions;
+    transitions.reserve(a.transitions.size());
+    for(const transition& t : a.transitions)
+      transitions.add(transition(old_state[t.start], t.terminal, old_state[t.end]));
+    result.initials = initials.build();
+    result.finals = finals.build();
+    result.transitions = transitions.build();
+    return result;
+  }
+
+}
+
       /* indice : utiliser un objet de type std::vector<set<int>> pour stocker
        * les ensembles d'états créés par l'algorithme de déterminisation.
        * Les états de l'automate déterministe retourné seront les indices
        * des ensembles d'états dans le vecteur. */
 
-automaton automaton::determine() const{
+automaton automaton::determine(unsigned threads) const{
+    automaton newAutomate; //Sans limite, la déterminisation aboutit toujours.
+    try_determine(determinization_budget(), newAutomate, threads);
+    return newAutomate;
+}
+
+bool automaton::try_determine(const determinization_budget& budget, automaton& result, unsigned threads) const{
 
     //Variable
-    std::vector<set<int>> states_newAutomate; //Etats du nouvel automate deterministe.
+    arena_scope arena; //Toutes les données temporaires de la déterminisation sont allouées dans cette arène, et libérées ensemble.
+    automaton nfa = *this; //Copie de "this", renumérotée avant de construire le moindre index : les numéros d'états écrits dans un fichier .lea peuvent être très grands.
+    nfa.compact();
+    nfa = nfa.collapse_epsilon_cycles().trim(); //Chaque cycle d'E-transitions est fusionné en un seul état, et les états inutiles sont retirés.
+    nfa.compact(); //Les états de "nfa" sont renumérotés de 0 à n-1, pour indexer directement les tableaux et les bitsets.
+    transition_index index(nfa.transitions, nfa.get_states().size()); //Transitions sortant de chaque état, construit une seule fois.
+    set<int> states = index.columns().states() | nfa.initials | nfa.finals; //Etats de l'automate "nfa", triés, en ne lisant que les colonnes d'états des transitions.
+    subset_pool states_newAutomate(states.size() > 0 ? states[states.size() - 1] + 1 : 0); //Etats du nouvel automate deterministe, identifiés par leur indice dans le pool.
     set<char> alphabet; //Alpabet de l'automate "this" et du deterministe.
     set<transition> newTrans; //Transition de l'automate deterministe.
     set<int> newFinals; //Etats finaux de l'automate deterministe.
     set<int> newInitial; //Etat initial de l'automate deterministe.
-    set<int> state; //Etat initial de l'ancien automate.
+    bitset finals_bits(nfa.finals); //Etats finaux de l'ancien automate.
+    closure_table closures(index); //E-clôture de chaque état, calculée une seule fois si elle tient en mémoire.
+    const std::uint32_t frontier_batch = 4096; //Nombre maximal d'états de la frontière dont les successeurs sont gardés en mémoire.
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); //Début de la déterminisation, pour le budget de temps.
+
+    //Indique si la déterminisation a dépassé son budget : nombre d'états, mémoire des ensembles d'états et des transitions, ou durée.
+    auto over_budget = [&]() {
+        std::size_t bytes = states_newAutomate.bytes() + newTrans.size() * sizeof(transition);
+        return (budget.max_states > 0 && states_newAutomate.size() > budget.max_states)
+            || (budget.max_bytes > 0 && bytes > budget.max_bytes)
+            || (budget.max_seconds > 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > budget.max_seconds);
+    };
 
 
 //Début
     if (this->is_deterministic()) {
         std::cout << "Cet automate est déjà deterministe, il est inutile d'appliquer la fonction ! " << std::endl;
-        return *this;
+        result = arena.copy_out(this->trim()); //Seuls les états accessibles et co-accessibles sont gardés.
+        return true;
 
     } else {
 
         //On insère dans le premier set tous les états initiaux du "this", pour former l'unique état initial de l'automate.
         //On ajoute toutes les éventuelles E-transition dans l'état initial du nouvel automate.
-        states_newAutomate.push_back(this->epsilon_accessible(this->initials));
+        bitset initial = closures.closure(bitset(nfa.initials));
+        states_newAutomate.intern(initial);
         newInitial |= 0; //Le premier état devient initial.
 
-        alphabet = this->get_alphabet(); //On cherche l'alphabet du "this".
-
-        bool final = false;
-        int s = 0;
+        alphabet = index.columns().alphabet(); //On cherche l'alphabet du "this", en ne lisant que la colonne des terminaux.
 
-        while(!final && s < states_newAutomate[0].size()){ //On vérifie si l'état initial est final.
-            final = this->finals.contains(states_newAutomate[0][s]);
-            s++;
-        }
-
-        if (final) { //S'il est final on l'ajoute à finals de l'automate
+        if (initial.intersects(finals_bits)) { //S'il est final on l'ajoute à finals de l'automate
             newFinals |= 0;
         }
 
-        //On parcours chaque nouvel état et chacune de leur transitions.
-        for (int i = 0; i < states_newAutomate.size(); ++i) {
-
-            for (char a : alphabet) {
-                set<int> newSet;
-
-                //On récupère tous les états qui recoivent une transition par ce caractère "a".
-                newSet |= epsilon_accessible(accessible(states_newAutomate[i],a));
-
-                if (newSet.size() > 0) { //Si l'état a une transition, on verifie la création de l'état.
-
-                    int index = 0;
-                    bool search = true;
-
-                    //On cherche à savoir si le nouvel état est déjà présent dans l'automate.
-                    while (search && index < states_newAutomate.size()) {
+        //On parcours les nouveaux états par niveaux : les états déjà créés mais pas encore parcourus forment la frontière.
+        //Les successeurs de la frontière sont calculés en parallèle, puis ajoutés dans l'ordre du parcours séquentiel,
+        //si bien que la numérotation des états ne dépend pas du nombre de threads.
+        std::vector<bitset> successors; //successors[(i - level) * alphabet.size() + j] : successeur de l'état i par alphabet[j].
+        for (std::uint32_t level = 0; level < states_newAutomate.size(); ) {
+            if (!budget.unlimited() && over_budget()) {
+                return false; //Le budget est dépassé : on abandonne, sans modifier "result".
+            }
+            std::uint32_t level_end = std::min<std::uint32_t>(states_newAutomate.size(), level + frontier_batch);
+            successors.assign((std::size_t)(level_end - level) * alphabet.size(), bitset());
 
-                        if (states_newAutomate[index] == newSet) {
-                            search = false;
-                        } else {
-                            index++;
-                        }
+            //On récupère tous les états qui recoivent une transition par chaque caractère, depuis chaque état de la frontière.
+            //L'arène n'est pas partagée entre les threads : ils allouent dans le tas global.
+            {
+                shared_heap_scope heap;
+                parallel_for(thread_count(threads), level, level_end, [&](std::uint32_t i) {
+                    bitset current = states_newAutomate[i];
+                    for (std::size_t j = 0; j < alphabet.size(); ++j) {
+                        successors[(std::size_t)(i - level) * alphabet.size() + j] = closures.closure(index.accessible(current, alphabet[j]));
                     }
+                });
+            }
 
-                    if (search) {
-                        states_newAutomate.push_back(newSet); //L'état n'existe pas, on le rajoute dans notre vector de set.
-                        newTrans |= transition(i, a, states_newAutomate.size() - 1); //Création de la transiotn vers ce nouvel état.
+            for (std::uint32_t i = level; i < level_end; ++i) {
+                for (std::size_t j = 0; j < alphabet.size(); ++j) {
+                    const bitset& newSet = successors[(std::size_t)(i - level) * alphabet.size() + j];
 
-                        final = false;
-                        int index2 = 0;
+                    if (!newSet.empty()) { //Si l'état a une transition, on verifie la création de l'état.
 
-                        //Cette fois, on vérifie si le nouvel état est final.
-                        while(!final && index2 < newSet.size()){
-                            final = this->finals.contains(newSet[index2]);
-                            index2++;
+                        //On cherche à savoir si le nouvel état est déjà présent dans l'automate, sinon on l'y ajoute.
+                        std::pair<std::uint32_t, bool> found = states_newAutomate.intern(newSet);
+
+                        //Ajout d'un nouvel état parmi les finaux.
+                        if (found.second && newSet.intersects(finals_bits)) {
+                            newFinals |= found.first;
                         }
-                        //Ajout de l'état parmi les finaux.
-                        if (final) {
-                            newFinals |= states_newAutomate.size() - 1;
+                        //Le budget est vérifié à chaque nouvel état, la durée seulement tous les 1024 états.
+                        if (found.second && !budget.unlimited() && (budget.max_states > 0 || budget.max_bytes > 0 || found.first % 1024 == 0) && over_budget()) {
+                            return false;
                         }
-                    } else {
-                        newTrans |= transition(i, a, index); //Pas besoin de création d'état, on creer simplement la transitions.
+                        newTrans |= transition(i, alphabet[j], found.first); //Création de la transition vers l'état.
                     }
                 }
             }
+            level = level_end;
         }
     }
         automaton newAutomate = automaton(); //Création du nouvel automate deterministe.
         newAutomate.initials = newInitial; //Ajout de l'état intial.
         newAutomate.finals = newFinals; //Ajout des états finaux.
         newAutomate.transitions = newTrans; //Ajout des transitions.
+        newAutomate = newAutomate.trim(); //Les états qui ne mènent à aucun état final sont retirés.
         newAutomate.name = this->name + " Version deterministe"; //Attribution du noms de l'automate.
 
-        return newAutomate;
+        result = arena.copy_out(newAutomate); //Le résultat est recopié hors de l'arène.
+        return true;
     }
 
 
+/*
+ * Renumbers the states from 0 to n-1, in breadth-first order from the initial states, then the inaccessible states
+ *
+ * The states are first ranked in the sorted set of states, so that the breadth-first search works on arrays
+ * whatever the original numbers. The transitions leaving a state are found by binary search in the sorted transitions.
+ */
+std::vector<int> automaton::compact() {
+  set<int> states = get_states();
+  auto rank = [&states](int q) { return std::lower_bound(states.begin(), states.end(), q) - states.begin(); };
+  std::vector<int> old_state;      // old_state[i] is the state renumbered i
+  std::vector<int> new_state(states.size(), -1); // new_state[rank(q)] is the new number of q, or -1
+  old_state.reserve(states.size());
+
+  auto visit = [&](int q) {
+    if(new_state[rank(q)] != -1) return;
+    new_state[rank(q)] = old_state.size();
+    old_state.push_back(q);
+  };
+  for(int q : initials) visit(q);
+  for(std::size_t next = 0; next < old_state.size(); ++next) {
+    int q = old_state[next];
+    auto first = std::lower_bound(transitions.begin(), transitions.end(), transition(q, CHAR_MIN, INT_MIN));
+    for(auto it = first; it != transitions.end() && it->start == q; ++it)
+      visit(it->end);
+  }
+  for(int q : states) visit(q);
+
+  set<int>::builder new_initials, new_finals;
+  for(int q : initials) new_initials.add(new_state[rank(q)]);
+  for(int q : finals) new_finals.add(new_state[rank(q)]);
+  set<transition>::builder new_transitions;
+  new_transitions.reserve(transitions.size());
+  for(const transition& t : transitions)
+    new_transitions.add(transition(new_state[rank(t.start)], t.terminal, new_state[rank(t.end)]));
+  initials = new_initials.build();
+  finals = new_finals.build();
+  transitions = new_transitions.build();
+  return old_state;
+}
+
+/*
+ * Gets an automaton that recognizes the same language, without the states that are not accessible or not co-accessible
+ *
+ * The accessible states are reached from the initial states through the transitions; the co-accessible states
+ * are reached from the final states through the reversed transitions, indexed in a second transition_index.
+ * Sparse states are renumbered first, and their numbers restored at the end.
+ */
+automaton automaton::trim() const {
+  std::size_t n = dense_state_count(*this);
+  if(n == 0) {
+    automaton dense = *this;
+    std::vector<int> old_state = dense.compact();
+    return renumbered(dense.trim(), old_state);
+  }
+  set<transition>::builder reversed;
+  reversed.reserve(transitions.size());
+  for(const transition& t : transitions)
+    reversed.add(transition(t.end, t.terminal, t.start));
+  bitset useful = transition_index(transitions, n).reachable(bitset(initials))
+    & transition_index(reversed.build(), n).reachable(bitset(finals));
+
+  automaton result;
+  result.name = name;
+  result.initials = initials;
+  set<int>::builder new_finals;
+  for(int q : finals)
+    if(useful.contains(q)) new_finals.add(q);
+  result.finals = new_finals.build();
+  set<transition>::builder new_transitions;
+  new_transitions.reserve(transitions.size());
+  for(const transition& t : transitions)
+    if(useful.contains(t.start) && useful.contains(t.end))
+      new_transitions.add(t);
+  result.transitions = new_transitions.build();
+  return result;
+}
+
+/*
+ * Gets an automaton that recognizes the same language, in which no cycle is made of epsilon transitions only
+ *
+ * Each state is replaced by the smallest state of its strongly connected component in the graph of epsilon transitions.
+ * The epsilon transitions that become loops are dropped. Sparse states are renumbered first, as in trim().
+ */
+automaton automaton::collapse_epsilon_cycles() const {
+  std::size_t n = dense_state_count(*this);
+  if(n == 0) {
+    automaton dense = *this;
+    std::vector<int> old_state = dense.compact();
+    return renumbered(dense.collapse_epsilon_cycles(), old_state);
+  }
+  std::vector<int> component = transition_index(transitions, n).epsilon_components();
+  bool collapsed = false;
+  for(std::size_t q = 0; q < component.size() && !collapsed; ++q)
+    collapsed = component[q] != (int)q;
+  if(!collapsed) return *this;
+
+  auto representative = [&component](int q) { return q >= 0 && (std::size_t)q < component.size() ? component[q] : q; };
+  automaton result;
+  result.name = name;
+  set<int>::builder new_initials, new_finals;
+  for(int q : initials) new_initials.add(representative(q));
+  for(int q : finals) new_finals.add(representative(q));
+  set<transition>::builder new_transitions;
+  new_transitions.reserve(transitions.size());
+  for(const transition& t : transitions) {
+    transition u(representative(t.start), t.terminal, representative(t.end));
+    if(!u.is_epsilon() || u.start != u.end)
+      new_transitions.add(u);
+  }
+  result.initials = new_initials.build();
+  result.finals = new_finals.build();
+  result.transitions = new_transitions.build();
+  return result;
+}
+
+/*
+ * Gets an upper bound of the number of states of the determinization, without determinizing
+ *
+ * The estimate works on the epsilon-free view of the automaton, as the determinization does: the states are
+ * renumbered, the cycles of epsilon transitions are collapsed, and the transitions labelled by c from a state q are
+ * those labelled by c from its epsilon closure. A set of states of the determinization is the closure of its kernel:
+ * the initial states, or the ends of the transitions by a symbol, so only the kernel states are counted. The states
+ * reachable from the successors of the branching states are found by a single traversal, started from all these
+ * successors at once; then the ends of the transitions are counted symbol by symbol, once sorted.
+ */
+double automaton::estimated_dfa_states() const {
+  automaton nfa = *this;
+  nfa.compact();
+  nfa = nfa.collapse_epsilon_cycles().trim();
+  nfa.compact();
+  transition_index index(nfa.transitions, nfa.get_states().size());
+  closure_table closures(index);
+  bitset kernel(nfa.initials);
+  for(std::size_t k = 0; k < index.columns().size(); ++k)
+    if(index.terminal(k) != '\0')
+      kernel |= index.end(k);
+  bitset seeds;
+  if(nfa.initials.size() > 1) seeds = bitset(nfa.initials);
+  std::vector<std::pair<char, int>> moves; // Transitions by a symbol from the closure of a kernel state
+  for(int q : kernel) {
+    moves.clear();
+    for(int p : closures.closure(bitset() | q)) {
+      std::pair<std::uint32_t, std::uint32_t> range = index.edges(p);
+      for(std::uint32_t k = range.first; k < range.second; ++k)
+	if(index.terminal(k) != '\0')
+	  moves.push_back(std::make_pair(index.terminal(k), index.end(k)));
+    }
+    std::sort(moves.begin(), moves.end());
+    moves.erase(std::unique(moves.begin(), moves.end()), moves.end());
+    bool branching = false;
+    for(std::size_t i = 1; i < moves.size() && !branching; ++i)
+      branching = moves[i].first == moves[i - 1].first;
+    if(branching)
+      for(const std::pair<char, int>& move : moves)
+	seeds |= move.second;
+  }
+  std::size_t n = kernel.size();
+  bitset shared = seeds.empty() ? bitset() : index.reachable(seeds) & kernel;
+  if(shared.empty()) return (double)n;
+  // The kernel of a set of states reached by c is made of ends of transitions labelled by c
+  std::vector<std::pair<char, int>> ends;
+  for(std::size_t k = 0; k < index.columns().size(); ++k)
+    if(index.terminal(k) != '\0')
+      ends.push_back(std::make_pair(index.terminal(k), index.end(k)));
+  std::sort(ends.begin(), ends.end());
+  ends.erase(std::unique(ends.begin(), ends.end()), ends.end());
+  double bound = 1; // The initial set of states
+  for(std::size_t i = 0; i < ends.size(); ) {
+    std::size_t d = 0, r = 0;
+    char c = ends[i].first;
+    for(; i < ends.size() && ends[i].first == c; ++i)
+      ++(shared.contains(ends[i].second) ? r : d);
+    bound += (double)(d + 1) * std::ldexp(1.0, (int)std::min<std::size_t>(r, 2000));
+  }
+  return bound;
+}
+
 /*
  * Gets whether the automaton is deterministic or not
  *
@@ -120,13 +368,13 @@ automaton automaton::determine() const{
 bool automaton::is_deterministic() const {
   // Check that there is a unique initial state
   if(initials.size() != 1) return false;
-  for(transition t1 : transitions) {
+  // Transitions are sorted by start state then terminal: two transitions with the same start
+  // state and the same label are consecutive, so a single pass is enough
+  for(std::size_t i = 0; i < transitions.size(); ++i) {
     // Check that there is no epsilon transition
-    if(t1.is_epsilon()) return false;
-    for(transition t2 : transitions) {
-      // Check that there are no two transitions starting in the same state, with the same label
-      if(t1.start == t2.start && t1.terminal == t2.terminal && t1.end != t2.end) return false;
-    }
+    if(transitions[i].is_epsilon()) return false;
+    // Check that there are no two transitions starting in the same state, with the same label
+    if(i > 0 && transitions[i].start == transitions[i-1].start && transitions[i].terminal == transitions[i-1].terminal) return false;
   }
   return true;
 }
@@ -141,18 +389,23 @@ bool automaton::is_deterministic() const {
  * Example : a.epsilon_accessible(a.initials) returns all states accessible in a, through the empty word. 
  */
 set<int> automaton::epsilon_accessible(set<int> from) const {
-  set<int> result = from;
-  bool go_on = true;
-  while (go_on) {
-    go_on = false;
-    for(transition t : transitions) {
-      if(result.contains(t.start) && t.terminal == '\0' && !result.contains(t.end)) {
-	result |= t.end;
-	go_on = true;
+  // The epsilon transitions leaving q are found by binary search: no array is indexed by the states, which can be sparse
+  set<int, hash_policy<int>> reached;
+  std::vector<int> pending(from.begin(), from.end());
+  for(int q : from) reached |= q;
+  while(!pending.empty()) {
+    int q = pending.back();
+    pending.pop_back();
+    auto first = std::lower_bound(transitions.begin(), transitions.end(), transition(q, '\0', INT_MIN));
+    for(auto it = first; it != transitions.end() && it->start == q && it->is_epsilon(); ++it)
+      if(!reached.contains(it->end)) {
+	reached |= it->end;
+	pending.push_back(it->end);
       }
-    }
   }
-  return result;
+  set<int>::builder result;
+  result.add(reached.begin(), reached.end());
+  return result.build();
 }
 
 /**
@@ -164,12 +417,35 @@ set<int> automaton::epsilon_accessible(set<int> from) const {
  * Example : a.epsilon_accessible(a.accessible(a.epsilon_accessible({1,2}),'a')) returns all states accessible in a, from states 1 or 2, through the word "a". 
  */
 set<int> automaton::accessible(set<int> from, char c) const {
-  set<int> result;
-  for(transition t : transitions) {
-    if(from.contains(t.start) && t.terminal == c)
-      result |= t.end;
+  set<int>::builder result;
+  for(int q : from) {
+    auto first = std::lower_bound(transitions.begin(), transitions.end(), transition(q, c, INT_MIN));
+    for(auto it = first; it != transitions.end() && it->start == q && it->terminal == c; ++it)
+      result.add(it->end);
   }
-  return result;
+  return result.build();
+}
+
+/*
+ * Dense version of epsilon_accessible: membership tests are single bit tests
+ *
+ * The transitions are indexed by start state, which costs O(|transitions|); repeated calls
+ * on the same automaton should build a transition_index once and use it directly, as determine() does.
+ * If the states of the automaton are too sparse to be indexed, the sparse version is used.
+ */
+bitset automaton::epsilon_accessible(bitset from) const {
+  std::size_t n = dense_state_count(*this);
+  if(n == 0) return bitset(epsilon_accessible(from.to_set()));
+  return transition_index(transitions, n).epsilon_accessible(std::move(from));
+}
+
+/*
+ * Dense version of accessible: membership tests are single bit tests
+ */
+bitset automaton::accessible(const bitset& from, char c) const {
+  std::size_t n = dense_state_count(*this);
+  if(n == 0) return bitset(accessible(from.to_set(), c));
+  return transition_index(transitions, n).accessible(from, c);
 }
 
 /*
@@ -178,19 +454,30 @@ set<int> automaton::accessible(set<int> from, char c) const {
  * A state is contained in the set returned if it is contained in initials, finals, or at the start or and of any transition.
  */
 set<int> automaton::get_states() const {
-  set<int> states = initials | finals;
-  for(transition t : transitions)
-    states |= {t.start, t.end};
-  return states;
+  set<int>::builder states;
+  states.reserve(initials.size() + finals.size() + 2 * transitions.size());
+  states.add(initials.begin(), initials.end());
+  states.add(finals.begin(), finals.end());
+  for(const transition& t : transitions) {
+    states.add(t.start);
+    states.add(t.end);
+  }
+  return states.build();
 }
 
 /*
  * Returns the set of terminal symbols (lower-case letters) that label at least one transition of the automaton
  */
 set<char> automaton::get_alphabet() const {
-  set<char> alphabet;
-  for(transition t : transitions)
+  // There are only 256 possible symbols: mark them, then list the marked ones in increasing order
+  bool used[UCHAR_MAX + 1] = {};
+  for(const transition& t : transitions)
     if(!t.is_epsilon())
-      alphabet |= {t.terminal};
-  return alphabet;
+      used[(unsigned char)t.terminal] = true;
+  char symbols[UCHAR_MAX + 1];
+  std::size_t n = 0;
+  for(int c = CHAR_MIN; c <= CHAR_MAX; ++c)
+    if(used[(unsigned char)c])
+      symbols[n++] = (char)c;
+  return set<char>::from_sorted_unique(symbols, symbols + n);
 }
@@ -10,7 +10,11 @@
  */
 
 #include "set.hpp"
+#include "bitset.hpp"
 #include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
 
 /**
  * \namespace univ_nantes Protects all definitions in the LEA project
@@ -69,6 +73,21 @@ namespace univ_nantes {
       return start==t.start && terminal == t.terminal && end == t.end;
     }
 
+    /**
+     * \fn bool operator< (const transition& t) const
+     * \brief Orders transitions lexicographically by start state, terminal and end state
+     * \param t a transition with which to compare *this
+     * \return true if *this comes strictly before t, false otherwise
+     *
+     * This order is the one used to store transitions in a set: the transitions leaving
+     * a given state are contiguous, and sorted by terminal.
+     */
+    bool operator< (const transition& t) const {
+      if(start != t.start) return start < t.start;
+      if(terminal != t.terminal) return terminal < t.terminal;
+      return end < t.end;
+    }
+
     /**
      * \fn friend std::ostream& operator<<(std::ostream& out, const transition& t)
      * \brief Inserts the description of the transition t into out
@@ -88,6 +107,33 @@ namespace univ_nantes {
     }
   };
 
+  /**
+   * \struct determinization_budget automaton.hpp
+   * \brief Limits of the resources taken by automaton::try_determine; a limit of 0 means no limit
+   */
+  struct determinization_budget {
+    std::size_t max_states = 0;  /*!< Maximal number of states of the deterministic automaton. */
+    std::size_t max_bytes = 0;   /*!< Maximal memory taken by the sets of states and the transitions built, in bytes. */
+    double max_seconds = 0;      /*!< Maximal duration of the determinization, in seconds. */
+
+    /**
+     * \fn bool unlimited() const
+     * \brief Gets whether the budget sets no limit at all
+     */
+    bool unlimited() const { return max_states == 0 && max_bytes == 0 && max_seconds <= 0; }
+  };
+
+  /**
+   * \enum minimization
+   * \brief Algorithms available to automaton::minimize
+   */
+  enum class minimization {
+    automatic,  /*!< Chooses one of the algorithms below from the estimates of the determinizations, see chosen_minimization. */
+    hopcroft,   /*!< Determinizes, then refines the partition of the states, completed with a sink, in O(n.k.log n). */
+    brzozowski, /*!< Reverses and determinizes twice: no partition at all, and no determinization of the automaton itself. */
+    valmari     /*!< Determinizes, then refines the states and the transitions of the partial automaton together, in O(m.log n). */
+  };
+
   
   /**
    * \struct automaton automaton.hpp 
@@ -95,7 +141,7 @@ namespace univ_nantes {
    */
   struct automaton {
   public:
-    std::string name;            /*!< Name of the automaton, or of the language recognized by the automaton. */
+    std::pmr::string name;       /*!< Name of the automaton, or of the language recognized by the automaton. */
     set<int> initials;           /*!< Set of initial states of the automaton. */
     set<int> finals;             /*!< Set of final (a.k.a. accepting) states of the automaton. */
     set<transition> transitions; /*!< Set of transitions of the automaton. */
@@ -145,13 +191,140 @@ namespace univ_nantes {
     set<int>  accessible(set<int> from, char c) const;
 
     /**
-     * \fn automaton determine() const
+     * \fn bitset epsilon_accessible(bitset from) const
+     * \brief Same as epsilon_accessible(set<int>), on dense sets of states
+     *
+     * Used by the determinization, where sets of states are compared, united and tested against the final states.
+     */
+    bitset    epsilon_accessible(bitset from) const;
+
+    /**
+     * \fn bitset accessible(const bitset& from, char c) const
+     * \brief Same as accessible(set<int>, char), on dense sets of states
+     */
+    bitset    accessible(const bitset& from, char c) const;
+
+    /**
+     * \fn std::vector<int> compact()
+     * \brief Renumbers the states of the automaton from 0 to n-1, where n is the number of states
+     * \return the old number of each state: the state numbered i after the call was numbered r[i] before
+     *
+     * The states accessible from the initial states are numbered first, in breadth-first order from the initial states
+     * taken in increasing order, following the transitions of each state in the order of the set of transitions.
+     * The other states are numbered next, in increasing order. The language recognized is not changed.
+     *
+     * State numbers written in .lea files or generated by the parser can be sparse and large; after compact(),
+     * they can index arrays and bitsets directly, and states visited together have close numbers.
+     */
+    std::vector<int> compact();
+
+    /**
+     * \fn automaton trim() const
+     * \brief Gets an automaton that recognizes the same language, without the states that are useless
+     * \return a copy of the automaton, keeping only the states that are both accessible from an initial state and
+     *         co-accessible from a final state, and the transitions between them
+     *
+     * The initial states are always kept, so that a deterministic automaton remains deterministic, even if it recognizes
+     * no word. The states are not renumbered: see compact().
+     */
+    automaton trim() const;
+
+    /**
+     * \fn automaton collapse_epsilon_cycles() const
+     * \brief Gets an automaton that recognizes the same language, in which no cycle is made of epsilon transitions only
+     * \return a copy of the automaton, in which the states of each cycle of epsilon transitions are merged into the smallest one
+     *
+     * The states of such a cycle are epsilon-accessible from each other, so merging them does not change the language.
+     * The resulting epsilon transitions form an acyclic graph, with fewer states in each epsilon closure.
+     */
+    automaton collapse_epsilon_cycles() const;
+
+    /**
+     * \fn automaton determine(unsigned threads = 1) const
      * \brief Gets a new deterministic automaton that recognizes the same language
+     * \param threads number of threads computing the subsets of states, or 0 for all hardware threads
      * \return a deterministic automaton 
      *
+     * The subsets are explored level by level: the successors of the states of the frontier are computed in parallel,
+     * then numbered in the order of a sequential exploration. The result is the same for any number of threads.
+     *
      * TODO: Question 1. Complete the given implementation of this function! 
      */
-    automaton determine() const;
+    automaton determine(unsigned threads = 1) const;
+
+    /**
+     * \fn bool try_determine(const determinization_budget& budget, automaton& result, unsigned threads = 1) const
+     * \brief Same as determine(), but gives up as soon as the determinization exceeds the budget
+     * \param budget the limits on the number of states, the memory and the duration of the determinization
+     * \param result receives the deterministic automaton, if the budget is not exceeded; it is not modified otherwise
+     * \param threads number of threads computing the subsets of states, or 0 for all hardware threads
+     * \return true if the automaton was determinized within the budget
+     */
+    bool try_determine(const determinization_budget& budget, automaton& result, unsigned threads = 1) const;
+
+    /**
+     * \fn double estimated_dfa_states() const
+     * \brief Gets an upper bound of the number of states of the determinization, computed without determinizing
+     * \return the bound, which may be infinite if it exceeds the range of double
+     *
+     * The estimate works on the automaton without epsilon transitions that the determinization explores: a state is
+     * branching if the transitions leaving its epsilon closure lead to two different states with the same label.
+     * Only the states that can start a set of states are counted: the initial states, and the ends of the transitions
+     * labelled by a symbol. If no state is branching and there is a single initial state, each set of states starts
+     * with one of these n states, hence the bound n.
+     *
+     * Otherwise, the states reachable from the successors of a branching state (or from the initial states, if there
+     * are several) can appear together in the sets of states; the other states can only be reached alone, by a single
+     * path. The set reached by a symbol c starts with ends of transitions labelled by c: if r_c of them can appear
+     * together and d_c others cannot, there are at most (d_c+1).2^r_c such sets, plus the initial set.
+     *
+     * The cost is that of the epsilon closures of the states counted, and of sorting the transitions. The bound is the
+     * number of useful states for deterministic automata, and 6.2^k+1 for (a|b)*a(a|b)^k, which has 2^(k+1)+1 sets of
+     * states; it is very pessimistic when few sets of states can actually be reached.
+     */
+    double estimated_dfa_states() const;
+
+    /**
+     * \fn automaton minimize(minimization strategy = minimization::automatic) const
+     * \brief Gets the deterministic automaton with the fewest states that recognizes the same language
+     * \param strategy the algorithm used to merge the equivalent states
+     * \return the minimal deterministic automaton, with states numbered in breadth-first order from its initial state 0
+     *
+     * The states from which no final state can be reached are removed, so the result may be partial. All strategies
+     * give the same automaton: they only differ in speed, see minimization.
+     */
+    automaton minimize(minimization strategy = minimization::automatic) const;
+
+    /**
+     * \fn bool try_minimize(minimization strategy, const determinization_budget& budget, automaton& result, unsigned threads = 1) const
+     * \brief Same as minimize(), but gives up as soon as one of the determinizations exceeds the budget
+     * \param strategy the algorithm used to merge the equivalent states
+     * \param budget the limits of each determinization, see try_determine
+     * \param result receives the minimal automaton, if the budget is not exceeded; it is not modified otherwise
+     * \param threads number of threads computing the subsets of states, or 0 for all hardware threads
+     * \return true if the automaton was minimized within the budget
+     *
+     * Brzozowski's algorithm determinizes twice, without determinizing the automaton itself: both determinizations
+     * are limited by the budget. The other strategies determinize the automaton once, if it is not deterministic.
+     */
+    bool try_minimize(minimization strategy, const determinization_budget& budget, automaton& result, unsigned threads = 1) const;
+
+    /**
+     * \fn minimization chosen_minimization(minimization strategy) const
+     * \brief Gets the algorithm run by minimize(strategy): strategy itself, or the choice of minimization::automatic
+     *
+     * The automatic strategy takes the algorithm of Valmari and Lehtinen, unless the automaton is not deterministic and
+     * the estimate of the determinization of its reverse is smaller than the one of its own determinization: Brzozowski's
+     * algorithm then determinizes the smaller automaton (see bench/minimize.cpp).
+     */
+    minimization chosen_minimization(minimization strategy) const;
+
+    /**
+     * \fn automaton reverse() const
+     * \brief Gets an automaton that recognizes the mirror of the language
+     * \return a copy of the automaton in which the initial and final states are swapped, and all transitions are reversed
+     */
+    automaton reverse() const;
 
     /**
      * \fn bool is_deterministic() const;
@@ -170,10 +343,27 @@ namespace univ_nantes {
      * \return true if *this and a are the same automata, false otherwise
      *
      * Two automata are considered equal if they have the same name and sets of initial and final states, and transitions.
-     * Set equality is defined by double inclusion (see univ_nantes::set).
+     * The sizes are compared first, so that most different automata are told apart without comparing their sets.
      */
     bool operator== (const automaton& a) const {
-      return name==a.name && initials == a.initials && finals==a.finals && transitions == a.transitions;
+      return name==a.name
+	&& initials.size() == a.initials.size() && finals.size() == a.finals.size() && transitions.size() == a.transitions.size()
+	&& initials == a.initials && finals==a.finals && transitions == a.transitions;
+    }
+
+    /**
+     * \fn bool operator< (const automaton& a) const
+     * \brief Orders automata by name, then lexicographically by initial states, final states and transitions
+     * \param a an automaton with which to compare *this
+     * \return true if *this comes strictly before a, false otherwise
+     *
+     * This total order is consistent with operator==, and is the one used to store automata in a set.
+     */
+    bool operator< (const automaton& a) const {
+      if(name != a.name) return name < a.name;
+      if(initials != a.initials) return std::lexicographical_compare(initials.begin(), initials.end(), a.initials.begin(), a.initials.end());
+      if(finals != a.finals) return std::lexicographical_compare(finals.begin(), finals.end(), a.finals.begin(), a.finals.end());
+      return std::lexicographical_compare(transitions.begin(), transitions.end(), a.transitions.begin(), a.transitions.end());
     }
 
     /**
@@ -196,4 +386,27 @@ namespace univ_nantes {
   
 }
 
+namespace std {
+  /**
+   * \brief Allows to use univ_nantes::transition as a key in unordered containers
+   */
+  template<> struct hash<univ_nantes::transition> {
+    std::size_t operator()(const univ_nantes::transition& t) const {
+      return univ_nantes::hash_combine(univ_nantes::hash_combine(std::hash<int>()(t.start), std::hash<char>()(t.terminal)), std::hash<int>()(t.end));
+    }
+  };
+
+  /**
+   * \brief Allows to use univ_nantes::automaton as a key in unordered containers
+   */
+  template<> struct hash<univ_nantes::automaton> {
+    std::size_t operator()(const univ_nantes::automaton& a) const {
+      std::size_t h = std::hash<std::pmr::string>()(a.name);
+      h = univ_nantes::hash_combine(h, a.initials.hash());
+      h = univ_nantes::hash_combine(h, a.finals.hash());
+      return univ_nantes::hash_combine(h, a.transitions.hash());
+    }
+  };
+}
+
 #endif // AUTOMATON_HPP_DEFINED
@@ -0,0 +1,121 @@
+/**
+ * \file bench/minimize.cpp
+ * \brief Benchmark of the algorithms of minimization, on deterministic and non-deterministic automata of several shapes
+ *
+ * The deterministic automata have n random states: complete over {a, b, c}, or partial with 3 transitions per state
+ * over 90 symbols. The non-deterministic automata are built for a parameter k: (a|b|c)*a(a|b|c)^k|(a|b|c)*, whose
+ * determinization has 2^(k+1) states but whose minimal automaton has one, and (a|b|c)^k a(a|b|c)*, whose reverse
+ * automaton is the one that explodes. The time of a minimization is printed in milliseconds, or "-" if it exceeds
+ * the budget of 10 seconds; the last columns are the estimates of the determinizations of the automaton and of its
+ * reverse, used by minimization::automatic.
+ */
+
+#include "automaton.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace univ_nantes;
+
+/**
+ * \fn automaton random_dfa(std::size_t n, const std::string& letters, std::size_t degree, std::mt19937& random)
+ * \brief Gets a deterministic automaton of n states, with degree transitions by distinct letters leaving each state
+ */
+automaton random_dfa(std::size_t n, const std::string& letters, std::size_t degree, std::mt19937& random) {
+  std::uniform_int_distribution<int> state(0, n - 1);
+  set<transition>::builder transitions;
+  set<int>::builder finals;
+  std::string shuffled = letters;
+  for(std::size_t q = 0; q < n; ++q) {
+    std::shuffle(shuffled.begin(), shuffled.end(), random);
+    for(std::size_t d = 0; d < degree; ++d)
+      transitions.add(transition(q, shuffled[d], state(random)));
+    if(random() % 2) finals.add(q);
+  }
+  automaton a;
+  a.initials = {0};
+  a.finals = finals.build();
+  a.transitions = transitions.build();
+  return a;
+}
+
+/**
+ * \fn automaton suffix_or_all(int k)
+ * \brief Gets an automaton of (a|b|c)*a(a|b|c)^k|(a|b|c)*
+ */
+automaton suffix_or_all(int k) {
+  automaton a;
+  a.initials = {0, k + 2};
+  a.finals = {k + 1, k + 2};
+  for(char c : {'a', 'b', 'c'}) {
+    a.transitions |= transition(0, c, 0);
+    a.transitions |= transition(k + 2, c, k + 2);
+    for(int q = 1; q <= k; ++q) a.transitions |= transition(q, c, q + 1);
+  }
+  a.transitions |= transition(0, 'a', 1);
+  return a;
+}
+
+/**
+ * \fn automaton prefix(int k)
+ * \brief Gets an automaton of (a|b|c)^k a(a|b|c)*
+ */
+automaton prefix(int k) {
+  automaton a;
+  a.initials = {0};
+  a.finals = {k + 1};
+  for(char c : {'a', 'b', 'c'}) {
+    for(int q = 0; q < k; ++q) a.transitions |= transition(q, c, q + 1);
+    a.transitions |= transition(k + 1, c, k + 1);
+  }
+  a.transitions |= transition(k, 'a', k + 1);
+  return a;
+}
+
+/**
+ * \fn void run(const char* shape, std::size_t size, const automaton& a)
+ * \brief Prints the time of each minimization of a, and the estimates of its determinizations
+ */
+void run(const char* shape, std::size_t size, const automaton& a) {
+  determinization_budget budget = { 0, 0, 10 };
+  std::printf("%-12s %6zu", shape, size);
+  std::size_t states = 0;
+  for(minimization strategy : {minimization::hopcroft, minimization::valmari, minimization::brzozowski, minimization::automatic}) {
+    // Fast minimizations are repeated for 200 milliseconds, so that the time is measurable
+    std::size_t runs = 0;
+    automaton minimal;
+    bool done = true;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> elapsed(0);
+    while(done && elapsed.count() < 200) {
+      done = a.try_minimize(strategy, budget, minimal);
+      ++runs;
+      elapsed = std::chrono::steady_clock::now() - start;
+    }
+    if(done) {
+      std::printf(" %10.3f", elapsed.count() / runs);
+      states = minimal.get_states().size();
+    } else {
+      std::printf(" %10s", "-");
+    }
+  }
+  std::printf(" %8zu %10.3g %10.3g\n", states, a.estimated_dfa_states(), a.reverse().estimated_dfa_states());
+}
+
+int main() {
+  std::mt19937 random(2022);
+  std::string symbols;
+  for(char c = '!'; symbols.size() < 90; ++c) symbols += c;
+
+  std::printf("%-12s %6s %10s %10s %10s %10s %8s %10s %10s\n", "shape", "size", "hopcroft", "valmari", "brzozowski",
+	      "automatic", "minimal", "estimate", "reverse");
+  for(std::size_t n : {100, 1000, 10000, 50000})
+    run("complete/3", n, random_dfa(n, "abc", 3, random));
+  for(std::size_t n : {100, 1000, 10000, 50000})
+    run("partial/90", n, random_dfa(n, symbols, 3, random));
+  for(int k : {4, 8, 12, 14})
+    run("suffix|all", k, suffix_or_all(k));
+  for(int k : {4, 8, 12, 14})
+    run("prefix", k, prefix(k));
+  return 0;
+}
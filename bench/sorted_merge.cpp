@@ -0,0 +1,115 @@
+/**
+ * \file bench/sorted_merge.cpp
+ * \brief Benchmark of the merge kernels of sorted_merge.hpp against the standard algorithms
+ *
+ * The sets are sorted arrays of n distinct states drawn among 4n, as the epsilon closures of the automata built
+ * by the parser, whose sizes range from a few states to a few thousands. Each kernel is run on the same pairs
+ * of sets, and its time per operation is printed in nanoseconds.
+ */
+
+#include "sorted_merge.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace univ_nantes;
+
+/**
+ * \fn std::vector<int> random_set(std::size_t n, std::mt19937& random)
+ * \brief Gets n distinct integers of {0, ..., 4n-1}, sorted
+ */
+std::vector<int> random_set(std::size_t n, std::mt19937& random) {
+  std::vector<int> all(4 * n);
+  for(std::size_t i = 0; i < all.size(); ++i) all[i] = i;
+  std::shuffle(all.begin(), all.end(), random);
+  all.resize(n);
+  std::sort(all.begin(), all.end());
+  return all;
+}
+
+/**
+ * \fn double time_per_operation(std::size_t operations, F body)
+ * \brief Runs body operations times, and gets the average time of a run, in nanoseconds
+ */
+template<typename F>
+double time_per_operation(std::size_t operations, F body) {
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < operations; ++i) body(i);
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / operations;
+}
+
+int main() {
+  std::mt19937 random(2020);
+  std::size_t checksum = 0;
+#ifdef SORTED_MERGE_SSE41
+  bool sse41 = int_merge::sse41_supported();
+#else
+  bool sse41 = false;
+#endif
+
+  std::printf("%6s %12s %12s %12s %12s %12s %12s %12s\n", "n", "std::inter", "inter", "inter_sse41",
+	      "std::union", "union", "std::diff", "diff");
+  for(std::size_t n : {8, 32, 128, 512, 2048, 8192}) {
+    // Enough different pairs that the branch predictor cannot learn them
+    std::size_t pairs = std::max<std::size_t>(16, (1 << 18) / n);
+    std::vector<std::vector<int>> a, b;
+    for(std::size_t p = 0; p < pairs; ++p) {
+      a.push_back(random_set(n, random));
+      b.push_back(random_set(n, random));
+    }
+    std::size_t operations = std::max<std::size_t>(pairs, (std::size_t)20000000 / n);
+    std::vector<int> out(2 * n + 3);
+
+    double std_inter = time_per_operation(operations, [&](std::size_t i) {
+      const std::vector<int>& x = a[i % pairs];
+      const std::vector<int>& y = b[i % pairs];
+      checksum += std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), out.begin()) - out.begin();
+    });
+    double inter = time_per_operation(operations, [&](std::size_t i) {
+      const std::vector<int>& x = a[i % pairs];
+      const std::vector<int>& y = b[i % pairs];
+      checksum += int_merge::intersect_scalar(x.data(), n, y.data(), n, out.data());
+    });
+    double inter_sse41 = 0;
+#ifdef SORTED_MERGE_SSE41
+    if(sse41)
+      inter_sse41 = time_per_operation(operations, [&](std::size_t i) {
+	const std::vector<int>& x = a[i % pairs];
+	const std::vector<int>& y = b[i % pairs];
+	checksum += int_merge::intersect(x.data(), n, y.data(), n, out.data());
+      });
+#endif
+    double std_union = time_per_operation(operations, [&](std::size_t i) {
+      const std::vector<int>& x = a[i % pairs];
+      const std::vector<int>& y = b[i % pairs];
+      checksum += std::set_union(x.begin(), x.end(), y.begin(), y.end(), out.begin()) - out.begin();
+    });
+    double unite = time_per_operation(operations, [&](std::size_t i) {
+      const std::vector<int>& x = a[i % pairs];
+      const std::vector<int>& y = b[i % pairs];
+      checksum += int_merge::unite(x.data(), n, y.data(), n, out.data());
+    });
+    double std_diff = time_per_operation(operations, [&](std::size_t i) {
+      const std::vector<int>& x = a[i % pairs];
+      const std::vector<int>& y = b[i % pairs];
+      checksum += std::set_difference(x.begin(), x.end(), y.begin(), y.end(), out.begin()) - out.begin();
+    });
+    double diff = time_per_operation(operations, [&](std::size_t i) {
+      const std::vector<int>& x = a[i % pairs];
+      const std::vector<int>& y = b[i % pairs];
+      std::copy(x.begin(), x.end(), out.begin());
+      checksum += int_merge::subtract(out.data(), n, y.data(), n);
+    });
+
+    if(sse41)
+      std::printf("%6zu %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n", n, std_inter, inter, inter_sse41, std_union, unite, std_diff, diff);
+    else
+      std::printf("%6zu %12.1f %12.1f %12s %12.1f %12.1f %12.1f %12.1f\n", n, std_inter, inter, "-", std_union, unite, std_diff, diff);
+  }
+  std::printf("(checksum %zu)\n", checksum);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * \file bench/transition_columns.cpp
+ * \brief Benchmark of the column-wise storage of transitions against the set of transitions, on 10^6-edge automata
+ *
+ * The automata have n states and 5 transitions per state, labelled by letters of {a, ..., z} or, once in 16,
+ * by epsilon, to random states. Each scan reads the same transitions in both layouts: the alphabet, the states
+ * at the ends of the transitions, and the successors of a quarter of the states by one letter, either by
+ * filtering all transitions or through transition_index. The time of a scan is printed in milliseconds.
+ */
+
+#include "automaton.hpp"
+#include "transition_columns.hpp"
+#include "transition_index.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace univ_nantes;
+
+/**
+ * \fn automaton random_automaton(std::size_t n, std::size_t degree, std::mt19937& random)
+ * \brief Gets an automaton of n states, with degree transitions leaving each state
+ */
+automaton random_automaton(std::size_t n, std::size_t degree, std::mt19937& random) {
+  std::uniform_int_distribution<int> state(0, n - 1);
+  std::uniform_int_distribution<int> letter(0, 25);
+  std::uniform_int_distribution<int> epsilon(0, 15);
+  set<transition>::builder transitions;
+  for(std::size_t q = 0; q < n; ++q)
+    for(std::size_t d = 0; d < degree; ++d)
+      transitions.add(transition(q, epsilon(random) == 0 ? '\0' : (char)('a' + letter(random)), state(random)));
+  automaton a;
+  a.transitions = transitions.build();
+  a.initials = {0};
+  return a;
+}
+
+/**
+ * \fn double time_per_run(std::size_t runs, F body)
+ * \brief Runs body runs times, and gets the average time of a run, in milliseconds
+ */
+template<typename F>
+double time_per_run(std::size_t runs, F body) {
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < runs; ++i) body();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / runs;
+}
+
+int main() {
+  std::mt19937 random(2020);
+  const std::size_t runs = 10;
+  std::size_t checksum = 0;
+
+  std::printf("%8s %9s %9s %9s %9s %9s %9s %9s %9s\n", "edges", "columns", "alph/set", "alph/col",
+	      "states/s", "states/c", "succ/set", "succ/col", "succ/idx");
+  for(std::size_t n : {20000, 200000, 400000}) {
+    automaton a = random_automaton(n, 5, random);
+    bitset from;
+    for(std::size_t q = 0; q < n; q += 4) from |= (int)q;
+    const char c = 'e';
+
+    transition_columns columns;
+    double build = time_per_run(runs, [&]() { columns = transition_columns(a.transitions); checksum += columns.size(); });
+    transition_index index(a.transitions, n);
+
+    double alphabet_set = time_per_run(runs, [&]() { checksum += a.get_alphabet().size(); });
+    double alphabet_columns = time_per_run(runs, [&]() { checksum += columns.alphabet().size(); });
+    double states_set = time_per_run(runs, [&]() { checksum += a.get_states().size(); });
+    double states_columns = time_per_run(runs, [&]() { checksum += columns.states().size(); });
+    double successors_set = time_per_run(runs, [&]() {
+      bitset result;
+      for(const transition& t : a.transitions)
+	if(t.terminal == c && from.contains(t.start))
+	  result |= t.end;
+      checksum += result.size();
+    });
+    double successors_columns = time_per_run(runs, [&]() {
+      bitset result;
+      const char* terminals = columns.terminal_data();
+      for(std::size_t k = 0; k < columns.size(); ++k)
+	if(terminals[k] == c && from.contains(columns.start(k)))
+	  result |= columns.end(k);
+      checksum += result.size();
+    });
+    double successors_index = time_per_run(runs, [&]() { checksum += index.accessible(from, c).size(); });
+
+    std::printf("%8zu %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", a.transitions.size(), build,
+		alphabet_set, alphabet_columns, states_set, states_columns, successors_set, successors_columns, successors_index);
+  }
+  std::printf("(checksum %zu)\n", checksum);
+  return 0;
+}
@@ -0,0 +1,410 @@
+#ifndef BITSET_HPP_DEFINED
+#define BITSET_HPP_DEFINED
+
+/**
+ * \file bitset.hpp
+ * \brief Header file containing the declaration of the bitset type, a dense set of non-negative integers.
+ */
+
+#include "set.hpp"
+#include "small_vector.hpp"
+#include <vector>
+#include <iostream>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace univ_nantes {
+
+  /**
+   * \namespace univ_nantes::words Word-parallel kernels on arrays of 64-bit words
+   *
+   * The kernels process the arrays by lanes of 256 bits (4 words). When the compiler targets AVX2,
+   * each lane is handled by a single vector instruction; otherwise, the scalar loops over a lane are
+   * simple enough to be vectorized by the compiler.
+   */
+  namespace words {
+
+    typedef std::uint64_t word;
+
+    /** dst[i] |= src[i] for 0 <= i < n */
+    inline void or_into(word* dst, const word* src, std::size_t n) {
+      std::size_t i = 0;
+#ifdef __AVX2__
+      for(; i + 4 <= n; i += 4) {
+	__m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+	__m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+	_mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(a, b));
+      }
+#endif
+      for(; i < n; ++i) dst[i] |= src[i];
+    }
+
+    /** dst[i] &= src[i] for 0 <= i < n */
+    inline void and_into(word* dst, const word* src, std::size_t n) {
+      std::size_t i = 0;
+#ifdef __AVX2__
+      for(; i + 4 <= n; i += 4) {
+	__m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+	__m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+	_mm256_storeu_si256((__m256i*)(dst + i), _mm256_and_si256(a, b));
+      }
+#endif
+      for(; i < n; ++i) dst[i] &= src[i];
+    }
+
+    /** dst[i] &= ~src[i] for 0 <= i < n */
+    inline void andnot_into(word* dst, const word* src, std::size_t n) {
+      std::size_t i = 0;
+#ifdef __AVX2__
+      for(; i + 4 <= n; i += 4) {
+	__m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+	__m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+	_mm256_storeu_si256((__m256i*)(dst + i), _mm256_andnot_si256(b, a));
+      }
+#endif
+      for(; i < n; ++i) dst[i] &= ~src[i];
+    }
+
+    /** true if a[i] & b[i] != 0 for some 0 <= i < n */
+    inline bool intersect(const word* a, const word* b, std::size_t n) {
+      std::size_t i = 0;
+#ifdef __AVX2__
+      for(; i + 4 <= n; i += 4) {
+	__m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+	__m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+	if(!_mm256_testz_si256(x, y)) return true;
+      }
+#endif
+      for(; i < n; ++i)
+	if(a[i] & b[i]) return true;
+      return false;
+    }
+
+    /** true if a[i] & ~b[i] == 0 for all 0 <= i < n */
+    inline bool included(const word* a, const word* b, std::size_t n) {
+      std::size_t i = 0;
+#ifdef __AVX2__
+      for(; i + 4 <= n; i += 4) {
+	__m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+	__m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+	if(!_mm256_testc_si256(y, x)) return false;
+      }
+#endif
+      for(; i < n; ++i)
+	if(a[i] & ~b[i]) return false;
+      return true;
+    }
+
+    /** true if a[i] == b[i] for all 0 <= i < n */
+    inline bool equal(const word* a, const word* b, std::size_t n) {
+      std::size_t i = 0;
+#ifdef __AVX2__
+      for(; i + 4 <= n; i += 4) {
+	__m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+	__m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+	__m256i d = _mm256_xor_si256(x, y);
+	if(!_mm256_testz_si256(d, d)) return false;
+      }
+#endif
+      for(; i < n; ++i)
+	if(a[i] != b[i]) return false;
+      return true;
+    }
+
+    /** number of words of a[0..n-1] once the trailing null words are removed */
+    inline std::size_t trimmed(const word* a, std::size_t n) {
+      while(n > 0 && a[n-1] == 0) --n;
+      return n;
+    }
+
+    /** hash of a[0..n-1], never null; a must not end with a null word */
+    inline std::size_t hash(const word* a, std::size_t n) {
+      std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ n;
+      for(std::size_t i = 0; i < n; ++i) {
+	h ^= a[i] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+	h *= 0xff51afd7ed558ccdULL;
+      }
+      h ^= h >> 33;
+      return h == 0 ? 1 : (std::size_t)h;
+    }
+
+    /** number of bits set in a[0..n-1] */
+    inline std::size_t count(const word* a, std::size_t n) {
+      std::size_t c = 0;
+      for(std::size_t i = 0; i < n; ++i) c += __builtin_popcountll(a[i]);
+      return c;
+    }
+  }
+
+  /**
+   * \class bitset bitset.hpp
+   * \brief Encodes sets of small non-negative integers, such as sets of states of an automaton, as arrays of bits
+   *
+   * The bit x of the array is set if, and only if, x is in the set. The array never ends with a null word,
+   * so that two equal sets have the same representation. This class offers the same operators as set<int>
+   * (|, &, - and comparisons), but they are computed by a few word operations instead of element by element.
+   * The elements are enumerated in increasing order.
+   *
+   * The words of sets of less than 256 elements are stored inline, so that the temporary sets of states of
+   * automata with up to 256 states never allocate memory.
+   */
+  class bitset {
+  public:
+    static const std::size_t inline_words = 4; /*!< Number of words stored without allocation: one 256-bit lane. */
+  private:
+    small_vector<words::word, inline_words> internal; /*!< internal[i] holds the elements 64*i to 64*i+63. */
+    mutable std::size_t hash_value = 0; /*!< Cached result of hash(), or 0 if it must be recomputed. */
+
+    /**
+     * \fn void trim()
+     * \brief Removes the null words at the end of the array, to keep the representation canonical
+     */
+    void trim() {
+      while(!internal.empty() && internal.back() == 0) internal.pop_back();
+    }
+
+  public:
+
+    /**
+     * \class const_iterator
+     * \brief Enumerates the elements of a bitset in increasing order, by scanning the bits set in each word
+     */
+    class const_iterator {
+    private:
+      const words::word* data;
+      std::size_t n;
+      std::size_t index;  /*!< index of the current word */
+      words::word rest;   /*!< bits of the current word that were not enumerated yet */
+
+      void skip() {
+	while(rest == 0 && index < n)
+	  if(++index < n) rest = data[index];
+      }
+
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef int value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const int* pointer;
+      typedef int reference;
+
+      const_iterator(const words::word* d, std::size_t size, std::size_t i) : data(d), n(size), index(i), rest(i < size ? d[i] : 0) { skip(); }
+      int operator*() const { return (int)(64 * index + __builtin_ctzll(rest)); }
+      const_iterator& operator++() { rest &= rest - 1; skip(); return *this; }
+      const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+      bool operator==(const const_iterator& it) const { return index == it.index && rest == it.rest; }
+      bool operator!=(const const_iterator& it) const { return !(*this == it); }
+    };
+
+    /**
+     * \fn bitset()
+     * \brief Default constructor
+     *
+     * creates an empty set
+     */
+    bitset() {}
+
+    /**
+     * \fn explicit bitset(const set<int>& s)
+     * \brief Builds the bitset containing the same (non-negative) elements as s
+     */
+    explicit bitset(const set<int>& s) {
+      for(int x : s) *this |= x;
+    }
+
+    /**
+     * \fn bitset(const words::word* data, std::size_t n)
+     * \brief Builds the bitset whose bits are given by the n words at data, which may end with null words
+     */
+    bitset(const words::word* data, std::size_t n) {
+      internal.insert(internal.end(), data, data + words::trimmed(data, n));
+    }
+
+    /**
+     * \fn bitset(std::size_t first, const words::word* data, std::size_t n)
+     * \brief Builds the bitset whose words first to first+n-1 are the n words at data, and whose previous words are null
+     */
+    bitset(std::size_t first, const words::word* data, std::size_t n) {
+      n = words::trimmed(data, n);
+      if(n == 0) return;
+      internal.resize(first, 0);
+      internal.insert(internal.end(), data, data + n);
+    }
+
+    /**
+     * \fn set<int> to_set() const
+     * \brief Gets a set<int> containing the same elements
+     */
+    set<int> to_set() const {
+      set<int> s;
+      for(int x : *this) s |= x;
+      return s;
+    }
+
+    /**
+     * \fn std::size_t size() const
+     * \brief Gets the number of elements in the set
+     */
+    std::size_t size() const { return words::count(internal.data(), internal.size()); }
+
+    /**
+     * \fn bool empty() const
+     * \brief Gets whether the set is empty, in constant time
+     */
+    bool empty() const { return internal.empty(); }
+
+    /**
+     * \fn bool contains(int x) const
+     * \brief Gets whether x is in the set, in constant time
+     */
+    bool contains(int x) const {
+      std::size_t i = (std::size_t)x / 64;
+      return x >= 0 && i < internal.size() && ((internal[i] >> (x % 64)) & 1);
+    }
+
+    /**
+     * \fn bool intersects(const bitset& rhs) const
+     * \brief Gets whether the set and rhs have an element in common
+     *
+     * Allows to test whether a set of states contains a final state without computing the intersection.
+     */
+    bool intersects(const bitset& rhs) const {
+      return words::intersect(internal.data(), rhs.internal.data(), std::min(internal.size(), rhs.internal.size()));
+    }
+
+    /**
+     * \fn const words::word* data() const
+     * \brief Gives a read-only access to the words of the canonical representation
+     */
+    const words::word* data() const { return internal.data(); }
+    /**
+     * \fn std::size_t word_count() const
+     * \brief Gets the number of words of the canonical representation
+     */
+    std::size_t word_count() const { return internal.size(); }
+
+    /**
+     * \fn std::size_t hash() const
+     * \brief Gets a hash of the set, computed from its canonical representation
+     *
+     * The value is cached until the next modification of the set, so that a subset used as a key
+     * in a hash table is hashed only once.
+     */
+    std::size_t hash() const {
+      if(hash_value == 0)
+	hash_value = words::hash(internal.data(), internal.size());
+      return hash_value;
+    }
+
+    const_iterator begin() const { return const_iterator(internal.data(), internal.size(), 0); }
+    const_iterator end() const { return const_iterator(internal.data(), internal.size(), internal.size()); }
+
+    /*********************************
+     *        Set operations         *
+     *********************************/
+
+    bitset& operator|=(const bitset& rhs) {
+      hash_value = 0;
+      if(internal.size() < rhs.internal.size()) internal.resize(rhs.internal.size(), 0);
+      words::or_into(internal.data(), rhs.internal.data(), rhs.internal.size());
+      return *this;
+    }
+
+    bitset& operator|=(int x) {
+      hash_value = 0;
+      std::size_t i = (std::size_t)x / 64;
+      if(internal.size() <= i) internal.resize(i + 1, 0);
+      internal[i] |= words::word(1) << (x % 64);
+      return *this;
+    }
+
+    bitset& operator&=(const bitset& rhs) {
+      hash_value = 0;
+      if(internal.size() > rhs.internal.size()) internal.resize(rhs.internal.size());
+      words::and_into(internal.data(), rhs.internal.data(), internal.size());
+      trim();
+      return *this;
+    }
+
+    bitset& operator&=(int x) {
+      bool found = contains(x);
+      internal.clear();
+      hash_value = 0;
+      if(found) *this |= x;
+      return *this;
+    }
+
+    bitset& operator-=(const bitset& rhs) {
+      hash_value = 0;
+      words::andnot_into(internal.data(), rhs.internal.data(), std::min(internal.size(), rhs.internal.size()));
+      trim();
+      return *this;
+    }
+
+    bitset& operator-=(int x) {
+      if(contains(x)) {
+	hash_value = 0;
+	internal[x / 64] &= ~(words::word(1) << (x % 64));
+	trim();
+      }
+      return *this;
+    }
+
+    friend bitset operator|(bitset lhs, const bitset& rhs) { lhs |= rhs; return lhs; }
+    friend bitset operator|(bitset lhs, int rhs) { lhs |= rhs; return lhs; }
+    friend bitset operator&(bitset lhs, const bitset& rhs) { lhs &= rhs; return lhs; }
+    friend bitset operator&(bitset lhs, int rhs) { lhs &= rhs; return lhs; }
+    friend bitset operator-(bitset lhs, const bitset& rhs) { lhs -= rhs; return lhs; }
+    friend bitset operator-(bitset lhs, int rhs) { lhs -= rhs; return lhs; }
+
+    /*********************************
+     *        Set comparison         *
+     *********************************/
+
+    friend bool operator<= (const bitset& lhs, const bitset& rhs) {
+      return lhs.internal.size() <= rhs.internal.size()
+	&& words::included(lhs.internal.data(), rhs.internal.data(), lhs.internal.size());
+    }
+    friend bool operator== (const bitset& lhs, const bitset& rhs) {
+      return lhs.internal.size() == rhs.internal.size()
+	&& (lhs.hash_value == 0 || rhs.hash_value == 0 || lhs.hash_value == rhs.hash_value)
+	&& words::equal(lhs.internal.data(), rhs.internal.data(), lhs.internal.size());
+    }
+    friend bool operator!= (const bitset& lhs, const bitset& rhs) { return !(lhs == rhs); }
+    friend bool operator>= (const bitset& lhs, const bitset& rhs) { return rhs <= lhs; }
+    friend bool operator<  (const bitset& lhs, const bitset& rhs) { return lhs <= rhs && lhs != rhs; }
+    friend bool operator>  (const bitset& lhs, const bitset& rhs) { return rhs < lhs; }
+
+    /**
+     * \fn friend std::ostream& operator<<(std::ostream& out, const bitset& e)
+     * \brief Inserts the description of the set e into out, in the same format as set<int>, e.g. "{1, 2, 3}".
+     */
+    friend std::ostream& operator<<(std::ostream& out, const bitset& e) {
+      out << "{" ;
+      bool first = true;
+      for(int x : e) {
+	if(!first) out << ", ";
+	out << x;
+	first = false;
+      }
+      return out << "}" ;
+    }
+  };
+
+}
+
+namespace std {
+  /**
+   * \brief Allows to use univ_nantes::bitset as a key in unordered containers
+   */
+  template<> struct hash<univ_nantes::bitset> {
+    std::size_t operator()(const univ_nantes::bitset& b) const { return b.hash(); }
+  };
+}
+
+#endif // BITSET_HPP_DEFINED
@@ -0,0 +1,67 @@
+/**
+ * \file byte_classes.cpp
+ * \brief Implementation file containing the code of the byte_classes type
+ */
+
+#include "byte_classes.hpp"
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace univ_nantes;
+
+byte_classes::byte_classes() : classes(1) {
+  std::fill(class_map, class_map + 256, 0);
+}
+
+byte_classes::byte_classes(const automaton& a) : byte_classes() {
+  refine(a);
+}
+
+byte_classes::byte_classes(const set<automaton>& automata) : byte_classes() {
+  for(const automaton& a : automata)
+    refine(a);
+}
+
+void byte_classes::refine(const automaton& a) {
+  // Classes are split with temporary ids, that are renumbered at the end
+  std::uint32_t work[256];
+  std::copy(class_map, class_map + 256, work);
+  std::uint32_t next_id = 256;
+
+  const set<transition>& transitions = a.transitions;
+  for(std::size_t i = 0; i < transitions.size(); ) {
+    // The transitions leaving a state are contiguous, sorted by terminal, then end state
+    std::size_t last = i;
+    while(last < transitions.size() && transitions[last].start == transitions[i].start) ++last;
+
+    // Bytes that lead to the same states from this state, and were in the same class, stay together;
+    // bytes that label no transition of this state are not moved
+    std::map<std::pair<std::uint32_t, std::vector<int>>, std::uint32_t> split;
+    for(std::size_t j = i; j < last; ) {
+      char c = transitions[j].terminal;
+      std::vector<int> ends;
+      for(; j < last && transitions[j].terminal == c; ++j)
+	ends.push_back(transitions[j].end);
+      if(c == '\0') continue;
+      auto key = std::make_pair(work[(unsigned char)c], std::move(ends));
+      auto found = split.find(key);
+      if(found == split.end())
+	found = split.insert(std::make_pair(std::move(key), next_id++)).first;
+      work[(unsigned char)c] = found->second;
+    }
+    i = last;
+  }
+
+  // A byte that labels a transition was given a new id, so only the bytes that label no transition keep id 0.
+  // The other ids are renumbered from 1, in increasing order of their smallest byte
+  std::map<std::uint32_t, std::uint8_t> ids;
+  ids[0] = 0;
+  for(int b = 0; b < 256; ++b) {
+    auto found = ids.find(work[b]);
+    if(found == ids.end()) found = ids.insert(std::make_pair(work[b], (std::uint8_t)ids.size())).first;
+    class_map[b] = found->second;
+  }
+  classes = ids.size();
+}
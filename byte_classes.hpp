@@ -0,0 +1,73 @@
+#ifndef BYTE_CLASSES_HPP_DEFINED
+#define BYTE_CLASSES_HPP_DEFINED
+
+/**
+ * \file byte_classes.hpp
+ * \brief Header file containing the declaration of the byte_classes type, a partition of the bytes into equivalence classes.
+ */
+
+#include "automaton.hpp"
+#include "set.hpp"
+#include <cstdint>
+
+namespace univ_nantes {
+
+  /**
+   * \class byte_classes byte_classes.hpp
+   * \brief Maps each byte to its equivalence class: two bytes are equivalent if they label the same transitions everywhere
+   *
+   * Two bytes b1 and b2 are in the same class if, for each state q of each automaton considered, the transitions
+   * leaving q labelled by b1 and by b2 lead to the same states. Reading b1 or b2 then has the same effect on all
+   * automata, and a transition table only needs one column per class instead of one per byte.
+   *
+   * Class 0 always contains the bytes that label no transition. The other classes are numbered from 1, in increasing
+   * order of their smallest byte. The classes are obtained by refining the partition with the transitions of each
+   * state, so the classes of several automata are computed by refining the same partition with each of them.
+   */
+  class byte_classes {
+  private:
+    std::uint8_t class_map[256]; /*!< class_map[b] is the class of the byte b. */
+    std::uint32_t classes;       /*!< Number of classes, including class 0. */
+
+  public:
+
+    /**
+     * \fn byte_classes()
+     * \brief Creates the partition with a single class 0, in which no byte labels any transition
+     */
+    byte_classes();
+
+    /**
+     * \fn explicit byte_classes(const automaton& a)
+     * \brief Creates the classes of the bytes for the automaton a
+     */
+    explicit byte_classes(const automaton& a);
+
+    /**
+     * \fn explicit byte_classes(const set<automaton>& automata)
+     * \brief Creates the classes of the bytes shared by all the given automata
+     */
+    explicit byte_classes(const set<automaton>& automata);
+
+    /**
+     * \fn void refine(const automaton& a)
+     * \brief Splits the classes, so that equivalent bytes are also equivalent for the automaton a
+     */
+    void refine(const automaton& a);
+
+    /**
+     * \fn std::uint32_t size() const
+     * \brief Gets the number of classes, including class 0
+     */
+    std::uint32_t size() const { return classes; }
+
+    /**
+     * \fn std::uint32_t operator[](char c) const
+     * \brief Gets the class of the byte c
+     */
+    std::uint32_t operator[](char c) const { return class_map[(unsigned char)c]; }
+  };
+
+}
+
+#endif // BYTE_CLASSES_HPP_DEFINED
@@ -0,0 +1,45 @@
+/**
+ * \file check/determine.cpp
+ * \brief Randomized check that determine() gives the same automaton for any number of threads
+ *
+ * The random automata are small, so their frontier fits in one batch; the determinization of the last automaton,
+ * (a|b|c)*a(a|b|c)^12, has 8192 states, so that its frontier is split in several batches of 4096 states.
+ */
+
+#include "random_automata.hpp"
+
+using namespace univ_nantes;
+
+/**
+ * \fn bool same_for_all_threads(const automaton& a)
+ * \brief Gets whether a.determine(threads) is a.determine(1), for 2, 3, 8 threads and all hardware threads
+ */
+bool same_for_all_threads(const automaton& a) {
+  automaton sequential = a.determine(1);
+  bool ok = true;
+  for(unsigned threads : {2u, 3u, 8u, 0u})
+    ok = expect(a.determine(threads) == sequential, "determine(" + std::to_string(threads) + ") differe de determine(1)", a) && ok;
+  return ok;
+}
+
+int main() {
+  std::mt19937 random(2023);
+  std::size_t failures = 0;
+
+  for(int i = 0; i < 300; ++i) {
+    automaton a = random_automaton(random, 16, "abc");
+    if(!a.is_deterministic() && !same_for_all_threads(a)) ++failures;
+  }
+
+  automaton big;
+  big.initials |= 0;
+  for(char c : {'a', 'b', 'c'}) big.transitions |= transition(0, c, 0);
+  big.transitions |= transition(0, 'a', 1);
+  for(int q = 1; q <= 12; ++q)
+    for(char c : {'a', 'b', 'c'}) big.transitions |= transition(q, c, q + 1);
+  big.finals |= 13;
+  if(!same_for_all_threads(big)) ++failures;
+
+  std::cout << "determine : " << failures << " erreur(s)" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
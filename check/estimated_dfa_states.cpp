@@ -0,0 +1,24 @@
+/**
+ * \file check/estimated_dfa_states.cpp
+ * \brief Randomized check that automaton::estimated_dfa_states is an upper bound of the size of determine()
+ */
+
+#include "random_automata.hpp"
+
+using namespace univ_nantes;
+
+int main() {
+  std::mt19937 random(2025);
+  std::size_t failures = 0;
+
+  for(int i = 0; i < 2000; ++i) {
+    automaton a = random_automaton(random, 30, i % 2 ? "ab" : "abc");
+    automaton dfa = a.is_deterministic() ? a.trim() : a.determine();
+    double estimate = a.estimated_dfa_states();
+    if(!expect(estimate >= dfa.get_states().size(), "l'estimation " + std::to_string(estimate) + " est inferieure aux "
+	       + std::to_string(dfa.get_states().size()) + " etats de determine()", a))
+      ++failures;
+  }
+  std::cout << "estimated_dfa_states : " << failures << " erreur(s)" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
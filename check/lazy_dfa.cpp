@@ -0,0 +1,56 @@
+/**
+ * \file check/lazy_dfa.cpp
+ * \brief Randomized check of lazy_dfa::accepts against the determinization, with caches of several sizes
+ *
+ * Each random automaton is matched on all the words of at most 6 symbols, and on longer random words, some of
+ * them with symbols that label no transition. With a cache of 64 bytes, the cache is flushed in the middle of
+ * most words: the check requires that this happens, so that the rebuild after a flush is actually exercised.
+ */
+
+#include "random_automata.hpp"
+#include "lazy_dfa.hpp"
+
+using namespace univ_nantes;
+
+/**
+ * \fn std::vector<std::string> words_up_to(const std::string& letters, std::size_t length)
+ * \brief Gets all the words of at most length symbols of letters
+ */
+std::vector<std::string> words_up_to(const std::string& letters, std::size_t length) {
+  std::vector<std::string> words(1, "");
+  for(std::size_t begin = 0, end = 1; length > 0; --length, begin = end, end = words.size())
+    for(std::size_t i = begin; i < end; ++i)
+      for(char c : letters)
+	words.push_back(words[i] + c);
+  return words;
+}
+
+int main() {
+  std::mt19937 random(2024);
+  std::vector<std::string> short_words = words_up_to("abc", 6);
+  std::size_t failures = 0, small_cache_flushes = 0;
+
+  for(int i = 0; i < 400; ++i) {
+    automaton a = random_automaton(random, 16, "abc");
+    compiled_dfa dfa(a.is_deterministic() ? a : a.determine());
+    std::vector<std::string> words = short_words;
+    for(int w = 0; w < 200; ++w)
+      words.push_back(random_word(random, w % 4 ? "abc" : "abcd ", 40));
+    for(std::size_t memory_cap : {(std::size_t)64, (std::size_t)1024, lazy_dfa::default_memory_cap}) {
+      lazy_dfa lazy(a, memory_cap);
+      bool ok = true;
+      for(std::size_t w = 0; w < words.size() && ok; ++w)
+	ok = expect(lazy.accepts(words[w]) == dfa.accepts(words[w]),
+		    "lazy_dfa(" + std::to_string(memory_cap) + ") et determine() different sur \"" + words[w] + "\"", a);
+      if(!ok) ++failures;
+      if(memory_cap == 64) small_cache_flushes += lazy.flushes();
+    }
+  }
+  if(small_cache_flushes == 0) {
+    std::cerr << "erreur : le cache de 64 octets n'a jamais ete vide" << std::endl;
+    ++failures;
+  }
+
+  std::cout << "lazy_dfa : " << failures << " erreur(s), " << small_cache_flushes << " vidage(s) du cache de 64 octets" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
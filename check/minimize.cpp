@@ -0,0 +1,80 @@
+/**
+ * \file check/minimize.cpp
+ * \brief Randomized check of the minimization strategies against determine() and a naive Moore refinement
+ *
+ * For each random automaton, every strategy of automaton::minimize must recognize the language of determine(),
+ * have as many states as the classes of the Moore equivalence of the determinized automaton, and give exactly
+ * the same automaton as the others.
+ */
+
+#include "random_automata.hpp"
+#include <algorithm>
+#include <map>
+
+using namespace univ_nantes;
+
+/**
+ * \fn std::size_t moore_state_count(const automaton& dfa)
+ * \brief Gets the number of states of the minimal automaton of the deterministic automaton dfa, naively
+ *
+ * The classes of states are refined by their signature (accepting, class of the successor by each symbol) on the
+ * complete automaton, until they are stable. The classes reachable from the initial state are counted, except the
+ * class of the sink state, which the minimal automaton omits unless it recognizes no word.
+ */
+std::size_t moore_state_count(const automaton& dfa) {
+  compiled_dfa d(dfa);
+  std::uint32_t n = d.state_count(), k = d.class_count();
+  std::vector<std::size_t> classes(n), refined(n);
+  for(std::uint32_t q = 0; q < n; ++q) classes[q] = d.is_accepting(q);
+  std::size_t count = 0;
+  while(true) {
+    std::map<std::vector<std::size_t>, std::size_t> signatures;
+    for(std::uint32_t q = 0; q < n; ++q) {
+      std::vector<std::size_t> signature(1, classes[q]);
+      for(std::uint32_t j = 0; j < k; ++j) signature.push_back(classes[d.next(q, j)]);
+      refined[q] = signatures.emplace(signature, signatures.size()).first->second;
+    }
+    classes.swap(refined);
+    if(signatures.size() == count) break;
+    count = signatures.size();
+  }
+  std::vector<bool> visited(n, false), reachable_classes(count, false);
+  std::vector<std::uint32_t> pending(1, 0);
+  visited[0] = true;
+  while(!pending.empty()) {
+    std::uint32_t q = pending.back();
+    pending.pop_back();
+    reachable_classes[classes[q]] = true;
+    for(std::uint32_t j = 0; j < k; ++j)
+      if(!visited[d.next(q, j)]) {
+	visited[d.next(q, j)] = true;
+	pending.push_back(d.next(q, j));
+      }
+  }
+  if(classes[0] != classes[d.sink()]) reachable_classes[classes[d.sink()]] = false;
+  return std::count(reachable_classes.begin(), reachable_classes.end(), true);
+}
+
+int main() {
+  std::mt19937 random(2022);
+  const minimization strategies[] = { minimization::automatic, minimization::hopcroft, minimization::brzozowski, minimization::valmari };
+  const char* names[] = { "automatic", "hopcroft", "brzozowski", "valmari" };
+  std::size_t failures = 0;
+
+  for(int i = 0; i < 2000; ++i) {
+    automaton a = random_automaton(random, 16, i % 2 ? "ab" : "abc");
+    automaton dfa = a.is_deterministic() ? a : a.determine();
+    std::size_t expected = moore_state_count(dfa);
+    automaton reference = a.minimize(minimization::hopcroft);
+    for(std::size_t s = 0; s < 4; ++s) {
+      automaton minimal = a.minimize(strategies[s]);
+      std::string strategy = names[s];
+      bool ok = expect(equivalent(minimal, dfa), "minimize(" + strategy + ") ne reconnait pas le langage de determine()", a)
+	&& expect(minimal.get_states().size() == expected, "minimize(" + strategy + ") n'a pas le nombre d'etats de Moore", a)
+	&& expect(minimal == reference, "minimize(" + strategy + ") differe de minimize(hopcroft)", a);
+      if(!ok) ++failures;
+    }
+  }
+  std::cout << "minimize : " << failures << " erreur(s)" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#ifndef CHECK_RANDOM_AUTOMATA_HPP_DEFINED
+#define CHECK_RANDOM_AUTOMATA_HPP_DEFINED
+
+/**
+ * \file check/random_automata.hpp
+ * \brief Random automata and words, and the comparisons shared by the randomized checks run by make check
+ */
+
+#include "automaton.hpp"
+#include "compiled_dfa.hpp"
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace univ_nantes {
+
+  /**
+   * \fn automaton random_automaton(std::mt19937& random, int max_states, const std::string& letters)
+   * \brief Gets an automaton of 2 to max_states states, labelled by letters, with some epsilon transitions
+   *
+   * State 0 is initial, and sometimes state 1 too. Each state is final with probability 1/3, and has 0 to 4
+   * transitions, so that the automata are partial, nondeterministic, and sometimes have inaccessible states.
+   */
+  inline automaton random_automaton(std::mt19937& random, int max_states, const std::string& letters) {
+    int n = 2 + random() % (max_states - 1);
+    automaton a;
+    a.initials |= 0;
+    if(random() % 4 == 0) a.initials |= 1;
+    for(int q = 0; q < n; ++q) {
+      if(random() % 3 == 0) a.finals |= q;
+      for(int d = random() % 5; d > 0; --d)
+	a.transitions |= transition(q, letters[random() % letters.size()], (int)(random() % n));
+      if(random() % 5 == 0) a.transitions |= transition(q, (int)(random() % n));
+    }
+    return a;
+  }
+
+  /**
+   * \fn std::string random_word(std::mt19937& random, const std::string& letters, std::size_t max_length)
+   * \brief Gets a word of at most max_length symbols of letters
+   */
+  inline std::string random_word(std::mt19937& random, const std::string& letters, std::size_t max_length) {
+    std::string word;
+    for(std::size_t length = random() % (max_length + 1); length > 0; --length)
+      word += letters[random() % letters.size()];
+    return word;
+  }
+
+  /**
+   * \fn bool equivalent(const automaton& x, const automaton& y)
+   * \brief Gets whether the deterministic automata x and y recognize the same language
+   *
+   * The pairs of states reachable in the product of x and y, completed by their sink states, are visited once:
+   * x and y are equivalent if none of them has exactly one accepting state.
+   */
+  inline bool equivalent(const automaton& x, const automaton& y) {
+    compiled_dfa dx(x), dy(y);
+    set<char> letters = x.get_alphabet() | y.get_alphabet();
+    std::vector<bool> visited((std::size_t)dx.state_count() * dy.state_count(), false);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pending;
+    auto visit = [&](std::uint32_t p, std::uint32_t q) {
+      if(!visited[(std::size_t)p * dy.state_count() + q]) {
+	visited[(std::size_t)p * dy.state_count() + q] = true;
+	pending.push_back(std::make_pair(p, q));
+      }
+    };
+    visit(x.initials.size() > 0 ? 0 : dx.sink(), y.initials.size() > 0 ? 0 : dy.sink());
+    while(!pending.empty()) {
+      std::pair<std::uint32_t, std::uint32_t> pq = pending.back();
+      pending.pop_back();
+      if(dx.is_accepting(pq.first) != dy.is_accepting(pq.second)) return false;
+      for(char c : letters)
+	visit(dx.next(pq.first, dx.symbol_class(c)), dy.next(pq.second, dy.symbol_class(c)));
+    }
+    return true;
+  }
+
+  /**
+   * \fn bool expect(bool condition, const std::string& what, const automaton& a)
+   * \brief Reports what, and the automaton a on which it happened, if condition is false
+   * \return condition
+   */
+  inline bool expect(bool condition, const std::string& what, const automaton& a) {
+    if(!condition) std::cerr << "erreur : " << what << " sur l'automate" << std::endl << a << std::endl;
+    return condition;
+  }
+
+}
+
+#endif // CHECK_RANDOM_AUTOMATA_HPP_DEFINED
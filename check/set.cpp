@@ -0,0 +1,140 @@
+/**
+ * \file check/set.cpp
+ * \brief Randomized check of set, with the sorted and the hash policies, against std::set
+ *
+ * Each round applies random insertions, removals, unions, intersections and differences to a set of each policy
+ * and to a std::set, and compares them after each operation. The elements are drawn among 64 integers, so that
+ * most operations hit existing elements, or among 100000, so that the hash tables grow, and are rebuilt by the
+ * removals, many times.
+ */
+
+#include "set.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace univ_nantes;
+
+/**
+ * \fn bool same(const S& s, const std::set<int>& expected)
+ * \brief Gets whether s has exactly the elements of expected, each one once, and contains them
+ */
+template<typename S>
+bool same(const S& s, const std::set<int>& expected) {
+  std::vector<int> elements(s.begin(), s.end());
+  std::sort(elements.begin(), elements.end());
+  if(s.size() != expected.size() || !std::equal(elements.begin(), elements.end(), expected.begin(), expected.end()))
+    return false;
+  for(int x : expected)
+    if(!s.contains(x)) return false;
+  return true;
+}
+
+/**
+ * \fn std::set<int> random_std_set(std::mt19937& random, int range, int size)
+ * \brief Gets a random set of up to size integers of {0, ..., range-1}
+ */
+std::set<int> random_std_set(std::mt19937& random, int range, int size) {
+  std::set<int> result;
+  for(int i = random() % (size + 1); i > 0; --i)
+    result.insert(random() % range);
+  return result;
+}
+
+/**
+ * \fn std::size_t check_policy(std::mt19937& random, const std::string& name)
+ * \brief Runs the random rounds on set<int, Policy>, and gets the number of errors
+ */
+template<typename Policy>
+std::size_t check_policy(std::mt19937& random, const std::string& name) {
+  typedef set<int, Policy> S;
+  std::size_t failures = 0;
+  for(int round = 0; round < 400; ++round) {
+    int range = round % 2 ? 64 : 100000;
+    S s;
+    std::set<int> expected;
+    for(int step = 0; step < 200 && failures < 10; ++step) {
+      int x = random() % range;
+      std::set<int> other = random_std_set(random, range, 48);
+      S rhs;
+      for(int y : other) rhs |= y;
+      std::string operation;
+      bool ok = true; // Whether the values returned by the operation are right
+      switch(random() % 8) {
+      case 0:
+      case 1:
+	operation = "insert(" + std::to_string(x) + ")";
+	ok = s.insert(x) == expected.insert(x).second && !s.insert(x);
+	break;
+      case 2:
+	operation = "-= " + std::to_string(x);
+	s -= x;
+	expected.erase(x);
+	if(!expected.empty()) {
+	  // An element that is in the set, so that the hash table is rebuilt
+	  int y = *std::next(expected.begin(), random() % expected.size());
+	  s -= y;
+	  expected.erase(y);
+	}
+	break;
+      case 3:
+	operation = "|= ensemble";
+	s |= rhs;
+	expected.insert(other.begin(), other.end());
+	break;
+      case 4: {
+	operation = "&= ensemble";
+	// Half of the time, rhs shares many elements with s
+	if(random() % 2)
+	  for(int y : expected)
+	    if(random() % 2) { rhs |= y; other.insert(y); }
+	s &= rhs;
+	std::set<int> kept;
+	std::set_intersection(expected.begin(), expected.end(), other.begin(), other.end(), std::inserter(kept, kept.end()));
+	expected = kept;
+	break;
+      }
+      case 5: {
+	operation = "-= ensemble";
+	s -= rhs;
+	std::set<int> kept;
+	std::set_difference(expected.begin(), expected.end(), other.begin(), other.end(), std::inserter(kept, kept.end()));
+	expected = kept;
+	break;
+      }
+      case 6: {
+	operation = "comparaisons";
+	bool included = std::includes(other.begin(), other.end(), expected.begin(), expected.end());
+	S copy = s;
+	ok = (s <= rhs) == included && (rhs >= s) == included && (s == rhs) == (expected == other)
+	  && (s != rhs) != (expected == other) && copy == s && s <= copy;
+	break;
+      }
+      default: {
+	operation = "copie et deplacement";
+	S copy = s, moved;
+	moved = std::move(copy);
+	s = moved;
+	ok = same(moved, expected) && copy.size() == 0;
+	break;
+      }
+      }
+      if(!ok || !same(s, expected)) {
+	std::cerr << "erreur : set<int, " << name << "> differe de std::set apres " << operation << std::endl;
+	++failures;
+      }
+    }
+  }
+  return failures;
+}
+
+int main() {
+  std::mt19937 random(2001);
+  std::size_t failures = check_policy<sorted_policy<int>>(random, "sorted_policy") + check_policy<hash_policy<int>>(random, "hash_policy");
+  std::cout << "set : " << failures << " erreur(s)" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/**
+ * \file check/set_builder.cpp
+ * \brief Randomized check of set::builder, set::from_sorted_unique and the insertion of ranges against std::set
+ *
+ * Each round fills a builder of each policy with unsorted elements and duplicates, one by one and by ranges, builds
+ * its set twice (the second one must be empty), and inserts ranges into the built set after reserving room for them.
+ * The ranges are drawn either above the elements of the set, which the sorted policy appends, or among them, which
+ * it merges: the check requires that both happen. The sets of sorted vectors are built by from_sorted_unique.
+ */
+
+#include "set.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace univ_nantes;
+
+/**
+ * \fn bool same(const S& s, const std::set<T>& expected)
+ * \brief Gets whether s has exactly the elements of expected, each one once, and contains them
+ */
+template<typename S, typename T>
+bool same(const S& s, const std::set<T>& expected) {
+  std::vector<T> elements(s.begin(), s.end());
+  std::sort(elements.begin(), elements.end());
+  if(s.size() != expected.size() || !std::equal(elements.begin(), elements.end(), expected.begin(), expected.end()))
+    return false;
+  for(const T& x : expected)
+    if(!s.contains(x)) return false;
+  return true;
+}
+
+/**
+ * \fn std::vector<int> random_elements(std::mt19937& random, int low, int high, int size)
+ * \brief Gets up to size integers of {low, ..., high-1}, in random order and possibly with duplicates
+ */
+std::vector<int> random_elements(std::mt19937& random, int low, int high, int size) {
+  std::vector<int> result(random() % (size + 1));
+  for(int& x : result) x = low + random() % (high - low);
+  return result;
+}
+
+/**
+ * \fn std::size_t check_policy(std::mt19937& random, const std::string& name, std::size_t& appends, std::size_t& merges)
+ * \brief Runs the random rounds on set<int, Policy>, counts the range insertions after and among the elements, and
+ * gets the number of errors
+ */
+template<typename Policy>
+std::size_t check_policy(std::mt19937& random, const std::string& name, std::size_t& appends, std::size_t& merges) {
+  typedef set<int, Policy> S;
+  std::size_t failures = 0;
+  for(int round = 0; round < 2000 && failures < 10; ++round) {
+    int range = round % 2 ? 32 : 100000;
+    std::set<int> expected;
+    typename S::builder builder;
+    if(random() % 2) builder.reserve(random() % 100);
+    std::size_t added = 0;
+    for(int step = random() % 4; step > 0; --step) {
+      std::vector<int> elements = random_elements(random, 0, range, 60);
+      if(random() % 2) builder.add(elements.begin(), elements.end());
+      else for(int x : elements) builder.add(x);
+      added += elements.size();
+      expected.insert(elements.begin(), elements.end());
+    }
+    bool ok = builder.size() == added;
+    S s = builder.build();
+    ok = ok && builder.size() == 0 && builder.build().size() == 0;
+    if(!ok || !same(s, expected)) {
+      std::cerr << "erreur : set<int, " << name << ">::builder differe de std::set apres " << added << " ajout(s)" << std::endl;
+      ++failures;
+    }
+
+    // Insertions of ranges, either above the largest element or among the elements
+    for(int step = 0; step < 4; ++step) {
+      int low = 0;
+      if(random() % 2 && !expected.empty()) {
+	low = *expected.rbegin() + 1;
+	++appends;
+      } else if(!expected.empty()) {
+	++merges;
+      }
+      std::vector<int> elements = random_elements(random, low, low + range, 40);
+      if(random() % 2) s.reserve(s.size() + elements.size());
+      s.insert(elements.begin(), elements.end());
+      expected.insert(elements.begin(), elements.end());
+      if(!same(s, expected)) {
+	std::cerr << "erreur : set<int, " << name << ">::insert differe de std::set apres " << elements.size() << " insertion(s) "
+		  << (low == 0 ? "parmi" : "apres") << " les elements" << std::endl;
+	++failures;
+      }
+    }
+
+    std::vector<int> sorted(expected.begin(), expected.end());
+    if(!same(S::from_sorted_unique(sorted.begin(), sorted.end()), expected)) {
+      std::cerr << "erreur : set<int, " << name << ">::from_sorted_unique differe de std::set" << std::endl;
+      ++failures;
+    }
+  }
+  return failures;
+}
+
+int main() {
+  std::mt19937 random(2010);
+  std::size_t appends = 0, merges = 0;
+  std::size_t failures = check_policy<sorted_policy<int>>(random, "sorted_policy", appends, merges)
+    + check_policy<hash_policy<int>>(random, "hash_policy", appends, merges);
+  if(appends == 0 || merges == 0) {
+    std::cerr << "erreur : les insertions d'intervalles n'ont pas ete faites a la fois apres et parmi les elements" << std::endl;
+    ++failures;
+  }
+
+  // The elements moved into the builder
+  for(int round = 0; round < 500 && failures < 10; ++round) {
+    std::set<std::string> expected;
+    set<std::string>::builder builder;
+    for(int x : random_elements(random, 0, 50, 30)) {
+      std::string element = std::to_string(x);
+      expected.insert(element);
+      builder.add(std::move(element));
+    }
+    if(!same(builder.build(), expected)) {
+      std::cerr << "erreur : set<std::string>::builder differe de std::set" << std::endl;
+      ++failures;
+    }
+  }
+
+  std::cout << "set_builder : " << failures << " erreur(s), " << appends << " insertion(s) apres et " << merges
+	    << " parmi les elements" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+/**
+ * \file check/small_vector.cpp
+ * \brief Randomized check of small_vector against std::vector, across the switch from inline to heap storage
+ *
+ * Each round applies random insertions, removals, resizes, copies, moves and swaps to a small_vector of 4 inline
+ * elements and to a std::vector, and compares them after each operation. The sizes stay around the inline capacity,
+ * so that the elements move between the object and the heap in both directions of copies and moves; the check
+ * requires that this happens. The bitsets, stored in a small_vector of 4 words, are also checked against std::set
+ * across 256 elements.
+ */
+
+#include "small_vector.hpp"
+#include "bitset.hpp"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace univ_nantes;
+
+typedef small_vector<int, 4> vector4;
+
+/**
+ * \fn bool same(const vector4& v, const std::vector<int>& expected)
+ * \brief Gets whether v has the elements of expected, in the same order, and room for them
+ */
+bool same(const vector4& v, const std::vector<int>& expected) {
+  return v.size() == expected.size() && v.capacity() >= v.size() && v.empty() == expected.empty()
+    && std::equal(v.begin(), v.end(), expected.begin(), expected.end());
+}
+
+int main() {
+  std::mt19937 random(2006);
+  std::size_t failures = 0, spills = 0;
+
+  for(int round = 0; round < 2000 && failures < 10; ++round) {
+    vector4 v;
+    std::vector<int> expected;
+    for(int step = 0; step < 40; ++step) {
+      bool was_inline = v.capacity() == 4;
+      int x = random() % 1000;
+      std::size_t position = random() % (expected.size() + 1);
+      std::string operation;
+      bool ok = true; // Whether the other vectors involved in the operation are right
+      switch(random() % 10) {
+      case 0:
+      case 1:
+	operation = "push_back";
+	v.push_back(x);
+	expected.push_back(x);
+	break;
+      case 2:
+	operation = "push_back d'un element du vecteur";
+	if(!expected.empty()) {
+	  v.push_back(v[position % v.size()]);
+	  expected.push_back(expected[position % expected.size()]);
+	}
+	break;
+      case 3:
+	operation = "insert";
+	v.insert(v.begin() + position, x);
+	expected.insert(expected.begin() + position, x);
+	break;
+      case 4: {
+	operation = "insert d'un intervalle";
+	std::vector<int> range(random() % 6, x);
+	for(std::size_t i = 0; i < range.size(); ++i) range[i] += i;
+	v.insert(v.begin() + position, range.begin(), range.end());
+	expected.insert(expected.begin() + position, range.begin(), range.end());
+	break;
+      }
+      case 5: {
+	operation = "erase";
+	std::size_t last = position + random() % (expected.size() - position + 1);
+	v.erase(v.begin() + position, v.begin() + last);
+	expected.erase(expected.begin() + position, expected.begin() + last);
+	break;
+      }
+      case 6:
+	operation = "resize";
+	v.resize(random() % 9, x);
+	expected.resize(v.size(), x);
+	break;
+      case 7: {
+	operation = "copie";
+	vector4 copy(v), assigned{1, 2, 3, 4, 5, 6};
+	assigned = copy;
+	v = assigned;
+	ok = same(copy, expected);
+	break;
+      }
+      case 8: {
+	operation = "deplacement";
+	vector4 moved(std::move(v)), assigned{1};
+	ok = v.empty();
+	assigned = std::move(moved);
+	v = std::move(assigned);
+	break;
+      }
+      default: {
+	operation = "swap";
+	std::vector<int> other_expected(random() % 8, x);
+	vector4 other(other_expected.size(), x);
+	v.swap(other);
+	ok = same(other, expected);
+	expected.swap(other_expected);
+	break;
+      }
+      }
+      // The capacity is 4 only in the inline storage: on the heap, it is at least twice the inline capacity
+      if(was_inline != (v.capacity() == 4)) ++spills;
+      if(!ok || !same(v, expected)) {
+	std::cerr << "erreur : small_vector differe de std::vector apres " << operation << std::endl;
+	++failures;
+      }
+    }
+  }
+  if(spills == 0) {
+    std::cerr << "erreur : small_vector n'est jamais passe du stockage interne au tas" << std::endl;
+    ++failures;
+  }
+
+  // The bitsets of less than 256 elements are inline, the larger ones are on the heap
+  for(int round = 0; round < 500; ++round) {
+    bitset b;
+    std::set<int> expected;
+    int range = round % 2 ? 256 : 1024;
+    for(int step = 0; step < 100; ++step) {
+      int x = random() % range;
+      if(random() % 3) { b |= x; expected.insert(x); }
+      else { b -= x; expected.erase(x); }
+    }
+    bitset copy = b;
+    if(!std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()) || copy.size() != expected.size()) {
+      std::cerr << "erreur : bitset differe de std::set" << std::endl;
+      ++failures;
+    }
+  }
+
+  std::cout << "small_vector : " << failures << " erreur(s), " << spills << " passage(s) entre stockage interne et tas" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/**
+ * \file check/sorted_merge.cpp
+ * \brief Randomized check of the merge kernels of sorted_merge.hpp against std::set_union, std::set_intersection
+ * and std::set_difference
+ *
+ * The sorted arrays have 0 to 300 distinct integers, drawn among a range from a few times to a hundred times their
+ * size, so that their intersections range from large to empty. The kernels of int_merge are called directly, the
+ * SSE4.1 intersection included if the processor supports it, and through the operators of set<int>, whose
+ * intersection takes the SSE4.1 kernel above sorted_merge<int>::simd_threshold elements: the check requires that
+ * this happens. The generic kernels are checked through set<std::string>.
+ */
+
+#include "set.hpp"
+#include "sorted_merge.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace univ_nantes;
+
+/**
+ * \fn std::vector<int> random_sorted(std::mt19937& random, std::size_t n, int range)
+ * \brief Gets up to n distinct integers of {-range/2, ..., range/2}, sorted
+ */
+std::vector<int> random_sorted(std::mt19937& random, std::size_t n, int range) {
+  std::vector<int> result;
+  for(std::size_t i = 0; i < n; ++i) result.push_back((int)(random() % (range + 1)) - range / 2);
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+/**
+ * \fn set<T> to_set(const std::vector<T>& v)
+ * \brief Gets the set of the sorted elements of v
+ */
+template<typename T>
+set<T> to_set(const std::vector<T>& v) {
+  return set<T>::from_sorted_unique(v.begin(), v.end());
+}
+
+/**
+ * \fn bool same(const set<T>& s, const std::vector<T>& expected)
+ * \brief Gets whether s enumerates the elements of expected, in the same order
+ */
+template<typename T>
+bool same(const set<T>& s, const std::vector<T>& expected) {
+  return s.size() == expected.size() && std::equal(s.begin(), s.end(), expected.begin(), expected.end());
+}
+
+int main() {
+  std::mt19937 random(2009);
+  std::size_t failures = 0, simd_intersections = 0;
+#ifdef SORTED_MERGE_SSE41
+  bool sse41 = int_merge::sse41_supported();
+#else
+  bool sse41 = false;
+#endif
+
+  for(int round = 0; round < 20000 && failures < 10; ++round) {
+    std::size_t n = random() % 300, m = random() % 300;
+    int range = (int)(std::max(n, m) + 1) * (2 + random() % 100);
+    std::vector<int> a = random_sorted(random, n, range), b = random_sorted(random, m, range);
+    std::vector<int> expected_union, expected_intersection, expected_difference;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_union));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_intersection));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_difference));
+
+    // The kernels on raw arrays
+    std::vector<int> out(a.size() + b.size() + 3);
+    out.resize(int_merge::unite(a.data(), a.size(), b.data(), b.size(), out.data()));
+    bool ok = out == expected_union;
+    out = a;
+    out.resize(int_merge::intersect_scalar(out.data(), out.size(), b.data(), b.size(), out.data()));
+    ok = ok && out == expected_intersection;
+    out = a;
+    out.resize(int_merge::subtract(out.data(), out.size(), b.data(), b.size()));
+    ok = ok && out == expected_difference;
+#ifdef SORTED_MERGE_SSE41
+    if(sse41) {
+      out.assign(std::min(a.size(), b.size()) + 3, 0);
+      out.resize(int_merge::intersect(a.data(), a.size(), b.data(), b.size(), out.data()));
+      ok = ok && out == expected_intersection;
+    }
+#endif
+    if(!ok) {
+      std::cerr << "erreur : les noyaux de int_merge different des algorithmes standard sur " << a.size() << " et " << b.size() << " entiers" << std::endl;
+      ++failures;
+    }
+
+    // The operators of set<int>
+    set<int> x = to_set(a), y = to_set(b);
+    if(sse41 && x.size() >= sorted_merge<int, std::less<int>>::simd_threshold && y.size() >= sorted_merge<int, std::less<int>>::simd_threshold)
+      ++simd_intersections;
+    if(!same(x | y, expected_union) || !same(x & y, expected_intersection) || !same(x - y, expected_difference)
+       || (x <= y) != std::includes(b.begin(), b.end(), a.begin(), a.end())) {
+      std::cerr << "erreur : les operations de set<int> different des algorithmes standard sur " << a.size() << " et " << b.size() << " entiers" << std::endl;
+      ++failures;
+    }
+  }
+  if(sse41 && simd_intersections == 0) {
+    std::cerr << "erreur : l'intersection SSE4.1 de set<int> n'a jamais ete appelee" << std::endl;
+    ++failures;
+  }
+
+  // The generic kernels, on strings
+  for(int round = 0; round < 2000 && failures < 10; ++round) {
+    std::vector<std::string> a, b;
+    for(int x : random_sorted(random, random() % 40, 100)) a.push_back(std::to_string(x));
+    for(int x : random_sorted(random, random() % 40, 100)) b.push_back(std::to_string(x));
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    std::vector<std::string> expected_union, expected_intersection, expected_difference;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_union));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_intersection));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_difference));
+    set<std::string> x = to_set(a), y = to_set(b);
+    if(!same(x | y, expected_union) || !same(x & y, expected_intersection) || !same(x - y, expected_difference)) {
+      std::cerr << "erreur : les operations de set<std::string> different des algorithmes standard" << std::endl;
+      ++failures;
+    }
+  }
+
+  std::cout << "sorted_merge : " << failures << " erreur(s), " << simd_intersections << " intersection(s) SSE4.1"
+	    << (sse41 ? "" : " (processeur sans SSE4.1)") << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+/**
+ * \file check/sparse_states.cpp
+ * \brief Check that automata whose states have very large numbers are handled without arrays indexed by these numbers
+ *
+ * The states written in a .lea file can be as large as INT_MAX. Each automaton of this check is also written with its
+ * states numbered from 0: every operation must give the same result on both, once the states are renumbered.
+ */
+
+#include "random_automata.hpp"
+#include "lazy_dfa.hpp"
+#include <climits>
+
+using namespace univ_nantes;
+
+/**
+ * \fn automaton spread(const automaton& a)
+ * \brief Gets a copy of a in which the state q is numbered INT_MAX - 2 * q, or 2000000000 + q if q is odd
+ */
+automaton spread(const automaton& a) {
+  auto number = [](int q) { return q % 2 ? 2000000000 + q : INT_MAX - 2 * q; };
+  automaton result;
+  for(int q : a.initials) result.initials |= number(q);
+  for(int q : a.finals) result.finals |= number(q);
+  for(const transition& t : a.transitions) result.transitions |= transition(number(t.start), t.terminal, number(t.end));
+  return result;
+}
+
+/**
+ * \fn automaton compacted(automaton a)
+ * \brief Gets a with its states numbered from 0, see automaton::compact()
+ */
+automaton compacted(automaton a) {
+  a.compact();
+  return a;
+}
+
+/**
+ * \fn bool same_transitions(const automaton& x, const automaton& y)
+ * \brief Gets whether x and y have the same states and transitions, whatever their names
+ */
+bool same_transitions(const automaton& x, const automaton& y) {
+  return x.initials == y.initials && x.finals == y.finals && x.transitions == y.transitions;
+}
+
+int main() {
+  std::mt19937 random(2015);
+  std::size_t failures = 0;
+
+  // The input of the bug report: it used to abort on std::bad_alloc
+  automaton report;
+  report.initials |= 2000000000;
+  report.finals |= 2000000001;
+  report.transitions |= transition(2000000000, 'a', 2000000001);
+  report.transitions |= transition(2000000000, 'a', 2000000000);
+  automaton expected;
+  expected.initials |= 0;
+  expected.finals |= 1;
+  expected.transitions |= transition(0, 'a', 1);
+  expected.transitions |= transition(1, 'a', 1);
+  if(!expect(same_transitions(report.determine(), expected), "determine() sur des etats tres grands", report)) ++failures;
+  if(!expect(same_transitions(report.minimize(), expected), "minimize() sur des etats tres grands", report)) ++failures;
+
+  for(int i = 0; i < 300; ++i) {
+    automaton dense = random_automaton(random, 12, "ab");
+    automaton sparse = spread(dense);
+    bool ok = expect(compacted(sparse.determine()) == compacted(dense.determine()), "determine() differe sur les etats tres grands", sparse)
+      && expect(sparse.minimize(minimization::brzozowski) == dense.minimize(minimization::brzozowski),
+		"minimize(brzozowski) differe sur les etats tres grands", sparse)
+      && expect(compacted(sparse.trim()) == compacted(spread(dense.trim())), "trim() differe sur les etats tres grands", sparse)
+      && expect(compacted(sparse.collapse_epsilon_cycles()).get_states().size() == compacted(dense.collapse_epsilon_cycles()).get_states().size(),
+		"collapse_epsilon_cycles() differe sur les etats tres grands", sparse)
+      && expect(sparse.estimated_dfa_states() == dense.estimated_dfa_states(), "estimated_dfa_states() differe sur les etats tres grands", sparse)
+      && expect(spread(dense).epsilon_accessible(sparse.initials).size() == dense.epsilon_accessible(dense.initials).size(),
+		"epsilon_accessible() differe sur les etats tres grands", sparse);
+    lazy_dfa lazy(sparse, 256);
+    compiled_dfa dfa(dense.determine());
+    for(int w = 0; w < 50 && ok; ++w) {
+      std::string word = random_word(random, "ab", 12);
+      ok = expect(lazy.accepts(word) == dfa.accepts(word), "lazy_dfa differe sur les etats tres grands, pour \"" + word + "\"", sparse);
+    }
+    if(!ok) ++failures;
+  }
+
+  std::cout << "sparse_states : " << failures << " erreur(s)" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
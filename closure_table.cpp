@@ -0,0 +1,52 @@
+/**
+ * \file closure_table.cpp
+ * \brief Implementation file containing the code of the closure_table type
+ */
+
+#include "closure_table.hpp"
+#include "small_vector.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace univ_nantes;
+
+closure_table::closure_table(const transition_index& index, std::size_t memory_cap) : index(index), stride((index.state_count() + 63) / 64) {
+  std::size_t n = index.state_count();
+  if(n == 0 || stride > memory_cap / sizeof(words::word) / n) return;
+  rows.assign(n * stride, 0);
+
+  std::vector<int> finished;
+  std::vector<int> component = index.epsilon_components(&finished);
+  // The states of a component are contiguous in finished, and come after the components they lead to
+  for(std::size_t first = 0; first < n; ) {
+    std::size_t last = first + 1;
+    while(last < n && component[finished[last]] == component[finished[first]]) ++last;
+    words::word* row = rows.data() + finished[first] * stride;
+    for(std::size_t i = first; i < last; ++i) {
+      int q = finished[i];
+      row[q / 64] |= words::word(1) << (q % 64);
+      std::pair<std::uint32_t, std::uint32_t> range = index.epsilon_edges(q);
+      for(std::uint32_t k = range.first; k < range.second; ++k) {
+	int r = index.epsilon_end(k);
+	if(component[r] != component[q])
+	  words::or_into(row, rows.data() + r * stride, stride);
+      }
+    }
+    // All the states of a component have the same closure
+    for(std::size_t i = first + 1; i < last; ++i)
+      std::copy(row, row + stride, rows.data() + finished[i] * stride);
+    first = last;
+  }
+}
+
+bitset closure_table::closure(const bitset& from) const {
+  if(!memoized()) return index.epsilon_accessible(from);
+  // States that are not indexed have no transition: they are their own closure
+  small_vector<words::word, bitset::inline_words> result(std::max(stride, from.word_count()), 0);
+  std::copy(from.data(), from.data() + from.word_count(), result.data());
+  for(int q : from) {
+    if((std::size_t)q >= index.state_count()) break;
+    words::or_into(result.data(), rows.data() + q * stride, stride);
+  }
+  return bitset(result.data(), result.size());
+}
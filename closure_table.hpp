@@ -0,0 +1,60 @@
+#ifndef CLOSURE_TABLE_HPP_DEFINED
+#define CLOSURE_TABLE_HPP_DEFINED
+
+/**
+ * \file closure_table.hpp
+ * \brief Header file containing the declaration of the closure_table type, which memoizes the epsilon closures of the states of an automaton.
+ */
+
+#include "transition_index.hpp"
+#include "bitset.hpp"
+#include <memory_resource>
+#include <cstddef>
+
+namespace univ_nantes {
+
+  /**
+   * \class closure_table closure_table.hpp
+   * \brief Bit matrix whose row q is the epsilon closure of the state q, so that the closure of a set is the union of its rows
+   *
+   * The rows are computed once, component by component of the graph of the epsilon transitions (see
+   * transition_index::epsilon_components), from the components without outgoing epsilon transitions to the others:
+   * the row of a state is the union of the rows of its epsilon successors, computed by word operations.
+   * Then closure(from) costs one union of rows per state of from, instead of a traversal of the epsilon transitions.
+   *
+   * The matrix takes state_count()^2 bits. When this exceeds the memory cap, no row is computed, and closure()
+   * follows the epsilon transitions on demand, with transition_index::epsilon_accessible.
+   *
+   * The table refers to the index it was built from, which must outlive it.
+   */
+  class closure_table {
+  private:
+    const transition_index& index;   /*!< Transitions of the automaton. */
+    std::size_t stride;              /*!< Number of words of each row. */
+    std::pmr::vector<words::word> rows; /*!< Row q occupies rows[q*stride .. (q+1)*stride-1]; empty if the rows are not memoized. */
+
+  public:
+    static const std::size_t default_memory_cap = 64 * 1024 * 1024; /*!< Default size above which the rows are not memoized, in bytes. */
+
+    /**
+     * \fn explicit closure_table(const transition_index& index, std::size_t memory_cap = default_memory_cap)
+     * \brief Computes the epsilon closures of all states of index, if they fit in memory_cap bytes
+     */
+    explicit closure_table(const transition_index& index, std::size_t memory_cap = default_memory_cap);
+
+    /**
+     * \fn bool memoized() const
+     * \brief Gets whether the closures of the states were computed, or are computed on demand
+     */
+    bool memoized() const { return index.state_count() == 0 || !rows.empty(); }
+
+    /**
+     * \fn bitset closure(const bitset& from) const
+     * \brief Same as automaton::epsilon_accessible
+     */
+    bitset closure(const bitset& from) const;
+  };
+
+}
+
+#endif // CLOSURE_TABLE_HPP_DEFINED
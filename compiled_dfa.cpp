@@ -0,0 +1,45 @@
+/**
+ * \file compiled_dfa.cpp
+ * \brief Implementation file containing the code of the compiled_dfa type
+ */
+
+#include "compiled_dfa.hpp"
+
+using namespace univ_nantes;
+
+compiled_dfa::compiled_dfa(const automaton& a) : compiled_dfa(a, byte_classes(a)) { }
+
+compiled_dfa::compiled_dfa(const automaton& a, const byte_classes& symbols) : name_(a.name.begin(), a.name.end()) {
+  automaton dfa = a;
+  dfa.compact();
+
+  classes = symbols.size();
+  for(int c = 0; c < 256; ++c)
+    class_map[c] = symbols[(char)c];
+
+  states = dfa.get_states().size() + 1;
+  width = states <= 0x100 ? 1 : states <= 0x10000 ? 2 : 4;
+  std::size_t entries = (std::size_t)states * classes;
+  switch(width) {
+  case 1: matrix8.assign(entries, sink()); break;
+  case 2: matrix16.assign(entries, sink()); break;
+  default: matrix32.assign(entries, sink()); break;
+  }
+  for(const transition& t : dfa.transitions) {
+    std::size_t i = (std::size_t)t.start * classes + class_map[(unsigned char)t.terminal];
+    switch(width) {
+    case 1: matrix8[i] = t.end; break;
+    case 2: matrix16[i] = t.end; break;
+    default: matrix32[i] = t.end; break;
+    }
+  }
+  accepting = bitset(dfa.finals);
+}
+
+bool compiled_dfa::accepts(const std::string& word) const {
+  switch(width) {
+  case 1: return run(matrix8.data(), word);
+  case 2: return run(matrix16.data(), word);
+  default: return run(matrix32.data(), word);
+  }
+}
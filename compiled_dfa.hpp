@@ -0,0 +1,145 @@
+#ifndef COMPILED_DFA_HPP_DEFINED
+#define COMPILED_DFA_HPP_DEFINED
+
+/**
+ * \file compiled_dfa.hpp
+ * \brief Header file containing the declaration of the compiled_dfa type, the frozen form of a deterministic automaton used by the backends.
+ */
+
+#include "automaton.hpp"
+#include "bitset.hpp"
+#include "byte_classes.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace univ_nantes {
+
+  /**
+   * \class compiled_dfa compiled_dfa.hpp
+   * \brief Immutable deterministic automaton, whose transitions are a dense matrix indexed by state and symbol class
+   *
+   * The bytes are first mapped to symbol classes (see byte_classes.hpp): class 0 gathers the bytes that label no transition,
+   * and bytes that label the same transitions everywhere share a class. The transition of state q by a byte c is then
+   * next(q, symbol_class(c)), read in a row-major matrix of state_count() rows and class_count() columns, which are
+   * usually a few entries wide.
+   *
+   * The states are those of the automaton after compact(), so the initial state is 0, plus a sink state numbered
+   * sink(), that is not accepting and loops on every class: missing transitions lead to it. The accepting states are
+   * given by a bitmap.
+   *
+   * The matrix stores each state in the smallest unsigned integer of 1, 2 or 4 bytes that can hold all states,
+   * given by state_width(). This type is the single input of the code generators, and of the matching in process.
+   */
+  class compiled_dfa {
+  private:
+    std::string name_;                 /*!< Name of the automaton. */
+    std::uint32_t states;              /*!< Number of states, including the sink state. */
+    std::uint32_t classes;             /*!< Number of symbol classes, including class 0. */
+    std::uint8_t class_map[256];       /*!< class_map[c] is the symbol class of the byte c. */
+    std::size_t width;                 /*!< Size in bytes of each entry of the matrix: 1, 2 or 4. */
+    std::vector<std::uint8_t> matrix8;   /*!< Matrix if width is 1: entry (q, k) is at index q*classes + k. */
+    std::vector<std::uint16_t> matrix16; /*!< Matrix if width is 2. */
+    std::vector<std::uint32_t> matrix32; /*!< Matrix if width is 4. */
+    bitset accepting;                  /*!< Accepting states. */
+
+    /**
+     * \fn bool run(const S* delta, const std::string& word) const
+     * \brief Matches word on the matrix delta, whose entries are of type S
+     */
+    template<typename S>
+    bool run(const S* delta, const std::string& word) const {
+      std::uint32_t q = initial();
+      for(char c : word)
+	q = delta[q * classes + class_map[(unsigned char)c]];
+      return is_accepting(q);
+    }
+
+  public:
+
+    /**
+     * \fn explicit compiled_dfa(const automaton& a)
+     * \brief Freezes the deterministic automaton a
+     * \param a an automaton such that a.is_deterministic() is true
+     */
+    explicit compiled_dfa(const automaton& a);
+
+    /**
+     * \fn compiled_dfa(const automaton& a, const byte_classes& symbols)
+     * \brief Freezes the deterministic automaton a, with the given classes of bytes
+     * \param a an automaton such that a.is_deterministic() is true
+     * \param symbols classes of bytes refined by a, for instance shared by several automata
+     */
+    compiled_dfa(const automaton& a, const byte_classes& symbols);
+
+    /**
+     * \fn const std::string& name() const
+     * \brief Gets the name of the automaton
+     */
+    const std::string& name() const { return name_; }
+
+    /**
+     * \fn std::uint32_t state_count() const
+     * \brief Gets the number of states, including the sink state
+     */
+    std::uint32_t state_count() const { return states; }
+
+    /**
+     * \fn std::uint32_t class_count() const
+     * \brief Gets the number of symbol classes, including the class 0 of the bytes that label no transition
+     */
+    std::uint32_t class_count() const { return classes; }
+
+    /**
+     * \fn std::uint32_t initial() const
+     * \brief Gets the initial state, which is always 0
+     */
+    std::uint32_t initial() const { return 0; }
+
+    /**
+     * \fn std::uint32_t sink() const
+     * \brief Gets the sink state, which is the last state
+     */
+    std::uint32_t sink() const { return states - 1; }
+
+    /**
+     * \fn std::size_t state_width() const
+     * \brief Gets the size in bytes of the unsigned integers that store the states in the matrix: 1, 2 or 4
+     */
+    std::size_t state_width() const { return width; }
+
+    /**
+     * \fn std::uint32_t symbol_class(char c) const
+     * \brief Gets the symbol class of c
+     */
+    std::uint32_t symbol_class(char c) const { return class_map[(unsigned char)c]; }
+
+    /**
+     * \fn std::uint32_t next(std::uint32_t q, std::uint32_t k) const
+     * \brief Gets the state reached from q by reading a symbol of class k
+     */
+    std::uint32_t next(std::uint32_t q, std::uint32_t k) const {
+      std::size_t i = (std::size_t)q * classes + k;
+      switch(width) {
+      case 1: return matrix8[i];
+      case 2: return matrix16[i];
+      default: return matrix32[i];
+      }
+    }
+
+    /**
+     * \fn bool is_accepting(std::uint32_t q) const
+     * \brief Gets whether q is an accepting state
+     */
+    bool is_accepting(std::uint32_t q) const { return accepting.contains(q); }
+
+    /**
+     * \fn bool accepts(const std::string& word) const
+     * \brief Gets whether the automaton recognizes word, by one lookup in the matrix per character
+     */
+    bool accepts(const std::string& word) const;
+  };
+
+}
+
+#endif // COMPILED_DFA_HPP_DEFINED
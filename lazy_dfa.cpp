@@ -0,0 +1,99 @@
+/**
+ * \file lazy_dfa.cpp
+ * \brief Implementation file containing the code of the lazy_dfa type
+ */
+
+#include "lazy_dfa.hpp"
+#include <algorithm>
+
+using namespace univ_nantes;
+
+const std::uint32_t lazy_dfa::unknown;
+
+/*
+ * Gets a copy of a whose states are numbered from 0, with the same preparation as the determinization: the states
+ * are renumbered before any index is built, since the numbers written in a .lea file can be very large
+ */
+static automaton prepare(const automaton& a) {
+  automaton nfa = a;
+  nfa.compact();
+  nfa = nfa.collapse_epsilon_cycles().trim();
+  nfa.compact();
+  return nfa;
+}
+
+lazy_dfa::lazy_dfa(const automaton& a, std::size_t memory_cap)
+  : name_(a.name.begin(), a.name.end()), nfa(prepare(a)), index(new transition_index(nfa.transitions, nfa.get_states().size())), closures(new closure_table(*index)),
+    symbols(nfa), states(nfa.get_states().size()), memory_cap(memory_cap), cache(states), current(0), flush_count(0) {
+  std::fill(representative, representative + 256, '\0');
+  for(int c = 255; c > 0; --c)
+    representative[symbols[(char)c]] = (char)c;
+  initial_states = closures->closure(bitset(nfa.initials));
+  final_states = bitset(nfa.finals);
+  reset();
+}
+
+std::size_t lazy_dfa::state_bytes() const {
+  // Words of the set, as stored by the generated program, its hash and slot, its row of transitions, and its accepting flag
+  return (states + 63) / 64 * sizeof(words::word) + sizeof(std::size_t) + 2 * sizeof(std::uint32_t)
+    + class_count() * sizeof(std::uint32_t) + 1;
+}
+
+std::size_t lazy_dfa::cache_capacity() const {
+  // The cache always holds at least the current state and its successor
+  return std::max<std::size_t>(2, memory_cap / state_bytes());
+}
+
+std::uint32_t lazy_dfa::add(const bitset& subset) {
+  std::pair<std::uint32_t, bool> found = cache.intern(subset);
+  if(found.second) {
+    delta.resize(delta.size() + class_count(), unknown);
+    accepting_states.push_back(subset.intersects(final_states));
+  }
+  return found.first;
+}
+
+void lazy_dfa::flush() {
+  cache = subset_pool(states);
+  delta.clear();
+  accepting_states.clear();
+  ++flush_count;
+}
+
+void lazy_dfa::reset() {
+  if(cache.size() >= cache_capacity() && !cache.contains(initial_states)) flush();
+  current = add(initial_states);
+}
+
+void lazy_dfa::read(char c) {
+  std::uint32_t k = symbols[c];
+  std::uint32_t next = delta[(std::size_t)current * class_count() + k];
+  if(next == unknown) {
+    bitset from = cache[current];
+    bitset to;
+    if(k != 0)
+      to = closures->closure(index->accessible(from, representative[k]));
+    if(cache.size() >= cache_capacity() && !cache.contains(to)) {
+      // The cache is rebuilt from the current state
+      flush();
+      current = add(from);
+    }
+    next = add(to);
+    delta[(std::size_t)current * class_count() + k] = next;
+  }
+  current = next;
+}
+
+bool lazy_dfa::accepts(const std::string& word) {
+  reset();
+  for(char c : word)
+    read(c);
+  return accepting();
+}
+
+bitset lazy_dfa::successors(std::uint32_t q, std::uint32_t k) const {
+  if(k == 0) return bitset();
+  bitset from;
+  from |= (int)q;
+  return closures->closure(index->accessible(from, representative[k]));
+}
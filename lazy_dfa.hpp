@@ -0,0 +1,176 @@
+#ifndef LAZY_DFA_HPP_DEFINED
+#define LAZY_DFA_HPP_DEFINED
+
+/**
+ * \file lazy_dfa.hpp
+ * \brief Header file containing the declaration of the lazy_dfa type, which determinizes an automaton on the fly while matching.
+ */
+
+#include "automaton.hpp"
+#include "bitset.hpp"
+#include "byte_classes.hpp"
+#include "subset_pool.hpp"
+#include "transition_index.hpp"
+#include "closure_table.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace univ_nantes {
+
+  /**
+   * \class lazy_dfa lazy_dfa.hpp
+   * \brief Matches words with a non-deterministic automaton, building the states of its determinization only when they are reached
+   *
+   * The determinization of an automaton can have exponentially many states, of which a word only visits a few. Here each
+   * state of the deterministic automaton, a set of states of the automaton, is computed the first time it is reached, and
+   * kept in a cache with its transitions, so that the next words that go through it need a single lookup per character.
+   *
+   * The cache is bounded by a memory cap. When a new state does not fit, the whole cache is flushed, except the current
+   * state, and is rebuilt from there: the matching stays correct, only slower if the cache is flushed often (see flushes()).
+   *
+   * The bytes are grouped in symbol classes as in compiled_dfa, and the automaton keeps the same transitions after
+   * collapse_epsilon_cycles(), trim() and compact(), so the sets of states are subsets of {0, ..., state_count()-1}.
+   */
+  class lazy_dfa {
+  private:
+    static const std::uint32_t unknown = 0xFFFFFFFF; /*!< Transition of the cache that was not computed yet. */
+
+    std::string name_;                          /*!< Name of the automaton. */
+    automaton nfa;                              /*!< Automaton simulated, with states numbered from 0. */
+    std::unique_ptr<transition_index> index;    /*!< Transitions of nfa; on the heap, since closures refers to it. */
+    std::unique_ptr<closure_table> closures;    /*!< Epsilon closures of the states of nfa. */
+    byte_classes symbols;                       /*!< Symbol classes of the bytes. */
+    char representative[256];                   /*!< representative[k] is a byte of the class k. */
+    bitset initial_states;                      /*!< Epsilon closure of the initial states. */
+    bitset final_states;                        /*!< Final states of nfa. */
+    std::uint32_t states;                       /*!< Number of states of nfa. */
+    std::size_t memory_cap;                     /*!< Size above which the cache is flushed, in bytes. */
+
+    subset_pool cache;                          /*!< States of the deterministic automaton computed so far. */
+    std::vector<std::uint32_t> delta;           /*!< delta[i*classes + k] is the successor of the cached state i by class k, or unknown. */
+    std::vector<bool> accepting_states;         /*!< accepting_states[i] is true if the cached state i contains a final state. */
+    std::uint32_t current;                      /*!< Cached state reached by the characters read since the last reset(). */
+    std::size_t flush_count;                    /*!< Number of times the cache was flushed. */
+
+    /**
+     * \fn std::uint32_t add(const bitset& states)
+     * \brief Gets the id of the cached state for the set states, adding it to the cache if needed
+     */
+    std::uint32_t add(const bitset& states);
+
+    /**
+     * \fn std::size_t state_bytes() const
+     * \brief Gets the memory taken by each cached state, with its transitions, in the tables of the generated program
+     *
+     * The generated program stores each set with the words of all the states, where the pool only keeps its non-null words.
+     */
+    std::size_t state_bytes() const;
+
+    /**
+     * \fn void flush()
+     * \brief Empties the cache
+     */
+    void flush();
+
+  public:
+    static const std::size_t default_memory_cap = 8 * 1024 * 1024; /*!< Default size of the cache, in bytes. */
+
+    /**
+     * \fn explicit lazy_dfa(const automaton& a, std::size_t memory_cap = default_memory_cap)
+     * \brief Prepares the matching of words with a, which may be non-deterministic, with a cache of memory_cap bytes
+     */
+    explicit lazy_dfa(const automaton& a, std::size_t memory_cap = default_memory_cap);
+
+    /**
+     * \fn const std::string& name() const
+     * \brief Gets the name of the automaton
+     */
+    const std::string& name() const { return name_; }
+
+    /**
+     * \fn void reset()
+     * \brief Goes back to the initial state, before the first character of a word
+     */
+    void reset();
+
+    /**
+     * \fn void read(char c)
+     * \brief Reads the next character of the word, computing the next state if it is not in the cache yet
+     */
+    void read(char c);
+
+    /**
+     * \fn bool accepting() const
+     * \brief Gets whether the characters read since the last reset() form a word recognized by the automaton
+     */
+    bool accepting() const { return accepting_states[current]; }
+
+    /**
+     * \fn bool accepts(const std::string& word)
+     * \brief Gets whether the automaton recognizes word; the cache is kept for the next words
+     */
+    bool accepts(const std::string& word);
+
+    /**
+     * \fn std::size_t cached_states() const
+     * \brief Gets the number of states of the deterministic automaton currently in the cache
+     */
+    std::size_t cached_states() const { return cache.size(); }
+
+    /**
+     * \fn std::size_t flushes() const
+     * \brief Gets the number of times the cache was flushed since the construction
+     */
+    std::size_t flushes() const { return flush_count; }
+
+    /**
+     * \fn std::size_t cache_capacity() const
+     * \brief Gets the number of states that fit in the cache
+     */
+    std::size_t cache_capacity() const;
+
+    /**
+     * \fn std::uint32_t state_count() const
+     * \brief Gets the number of states of the automaton simulated
+     */
+    std::uint32_t state_count() const { return states; }
+
+    /**
+     * \fn std::uint32_t class_count() const
+     * \brief Gets the number of symbol classes, including the class 0 of the bytes that label no transition
+     */
+    std::uint32_t class_count() const { return symbols.size(); }
+
+    /**
+     * \fn std::uint32_t symbol_class(char c) const
+     * \brief Gets the symbol class of c
+     */
+    std::uint32_t symbol_class(char c) const { return symbols[c]; }
+
+    /**
+     * \fn const bitset& initials() const
+     * \brief Gets the states of the automaton in which the words start, epsilon transitions included
+     */
+    const bitset& initials() const { return initial_states; }
+
+    /**
+     * \fn const bitset& finals() const
+     * \brief Gets the final states of the automaton
+     */
+    const bitset& finals() const { return final_states; }
+
+    /**
+     * \fn bitset successors(std::uint32_t q, std::uint32_t k) const
+     * \brief Gets the states reached from the state q by reading a symbol of class k, epsilon transitions included
+     *
+     * The successors of a set of states are the union of the successors of its states: this is what the code generators
+     * emit, so that the generated program can compute the states of the cache by itself.
+     */
+    bitset successors(std::uint32_t q, std::uint32_t k) const;
+  };
+
+}
+
+#endif // LAZY_DFA_HPP_DEFINED
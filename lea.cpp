@@ -8,9 +8,12 @@
 
 #include "automaton.hpp"
 #include "set.hpp"
+#include "compiled_dfa.hpp"
+#include "lazy_dfa.hpp"
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 
 using namespace univ_nantes;
 using namespace std;
@@ -26,26 +29,91 @@ using namespace std;
 set<automaton> read_lea_file(char* file);
 
 /**
- * \fn bool check(set<automaton> automata)
+ * \var bool minimize_automata
+ * \brief Whether the parsed automata are minimized after their determinization, true unless the option -n is given
+ *
+ * This variable is defined in File parser.yxx
+ */
+extern bool minimize_automata;
+
+/**
+ * \var minimization minimization_strategy
+ * \brief Algorithm used to minimize the parsed automata, set by the option -m
+ *
+ * This variable is defined in File parser.yxx
+ */
+extern minimization minimization_strategy;
+
+/**
+ * \var unsigned determinization_threads
+ * \brief Number of threads used to determinize the parsed automata, set by the option -j (0 for all hardware threads)
+ *
+ * This variable is defined in File parser.yxx
+ */
+extern unsigned determinization_threads;
+
+/**
+ * \var bool lazy_automata
+ * \brief Whether the parsed automata are kept non-deterministic, for the lazy backend chosen by the option -l
+ *
+ * This variable is defined in File parser.yxx
+ */
+extern bool lazy_automata;
+
+/**
+ * \var determinization_budget determinization_limits
+ * \brief Limits of the determinization of each parsed automaton, set by the options -S, -M and -T (1 GiB by default)
+ *
+ * An automaton whose determinization exceeds them is kept non-deterministic, and goes to the lazy backend.
+ * This variable is defined in File parser.yxx
+ */
+extern determinization_budget determinization_limits;
+
+/**
+ * \var set<string> lazy_fallbacks
+ * \brief Names of the non-deterministic parsed automata whose determinization exceeded determinization_limits
+ *
+ * These automata are kept as they are, and go to the lazy backend.
+ * This variable is defined in File parser.yxx
+ */
+extern set<string> lazy_fallbacks;
+
+/**
+ * \fn bool is_lazy(const automaton& a)
+ * \brief Gets whether a goes to the lazy backend: with the option -l, or if its determinization exceeded the limits
+ */
+bool is_lazy(const automaton& a);
+
+/**
+ * \fn bool check(const set<automaton>& automata)
  * \brief Checks that the automata are well-formed to generate the output file 
  * \param automata the set of automata to check
  * \return true if everything is correct
  *
  * This functions does the following checks:
  * 1) There is at least one automaton
- * 2) all automata are deterministic
+ * 2) all automata are deterministic, except those that go to the lazy backend (see is_lazy)
  * 3) all automata have a name
  * 4) all automata have a different name
  */
-bool check(set<automaton> automata);
+bool check(const set<automaton>& automata);
 
 /**
- * \fn void generate_c_file(ostream & out, set<automaton> automata)
+ * \fn void generate_c_file(ostream & out, const vector<compiled_dfa>& automata, const vector<lazy_dfa>& lazy_automata)
  * \brief Generates the c code executing the given automata
  * \param out the stream in which the c code must be included
- * \param automata the set of automata to print
+ * \param automata the compiled automata to print
+ * \param lazy_automata the automata to determinize on the fly in the generated program
+ *
+ * Each compiled automaton is printed as three constant arrays: the symbol class of each byte, the transition matrix,
+ * and the accepting states. The generated program reads one lookup per automaton and character.
+ *
+ * Each lazy automaton is printed as its symbol classes, and the list of the successors of each of its states by each
+ * class: the lists are stored one after the other, and an array of offsets gives where each list starts. The generated
+ * program then builds the bitmaps of the states of the deterministic automaton while reading, in a cache of the size
+ * of lazy_dfa::cache_capacity(), which is flushed when it is full (see lazy_dfa.hpp).
  */
-void generate_c_file(ostream& out, set<automaton> automata);
+void generate_c_file(ostream& out, const vector<compiled_dfa>& automata, const vector<lazy_dfa>& lazy_automata);
 
 
 /**
@@ -58,6 +126,7 @@ void generate_c_file(ostream& out, set<automaton> automata);
 int main(int argc, char *argv[]) {
   set<automaton> automata;
   string output = "output.c";
+  vector<char*> inputs;
 
   // Read the arguments in the command line
   for(int i = 1; i<argc; i++) {
@@ -67,32 +136,83 @@ int main(int argc, char *argv[]) {
 	if(*option=='o') { // -o option: used to define an output file
 	  output = (string)argv[i+1];
 	  i++;
+	} else if(*option=='n') { // -n option: keeps the automata as determinized, without minimizing them
+	  minimize_automata = false;
+	} else if(*option=='m') { // -m option: chooses the algorithm of minimization
+	  string strategy = i+1<argc ? argv[i+1] : "";
+	  if(strategy=="auto") minimization_strategy = minimization::automatic;
+	  else if(strategy=="hopcroft") minimization_strategy = minimization::hopcroft;
+	  else if(strategy=="valmari") minimization_strategy = minimization::valmari;
+	  else if(strategy=="brzozowski") minimization_strategy = minimization::brzozowski;
+	  else {
+	    cerr << "erreur : minimisation inconnue " << strategy << " (auto, hopcroft, valmari ou brzozowski)" << endl;
+	    exit(1);
+	  }
+	  i++;
+	} else if(*option=='j') { // -j option: number of threads used by the determinization
+	  determinization_threads = i+1<argc ? atoi(argv[i+1]) : 1;
+	  i++;
+	} else if(*option=='l') { // -l option: determinizes the automata on the fly in the generated program
+	  lazy_automata = true;
+	} else if(*option=='S') { // -S option: maximal number of states of a determinized automaton
+	  determinization_limits.max_states = i+1<argc ? strtoull(argv[i+1], nullptr, 10) : 0;
+	  i++;
+	} else if(*option=='M') { // -M option: maximal memory taken by a determinization, in MiB
+	  determinization_limits.max_bytes = (i+1<argc ? strtoull(argv[i+1], nullptr, 10) : 0) * 1024 * 1024;
+	  i++;
+	} else if(*option=='T') { // -T option: maximal duration of a determinization, in seconds
+	  determinization_limits.max_seconds = i+1<argc ? atof(argv[i+1]) : 0;
+	  i++;
 	} else if(*option=='h') { // -h option: prints the help
 	  cout << "usage example: ./lea input.lea -o output.c" << endl;
+	  cout << "options: -o <file> output file, -n do not minimize the automata, "
+	       << "-m <auto|hopcroft|valmari|brzozowski> algorithm of minimization, "
+	       << "-j <n> threads for the determinization (0: all cores), "
+	       << "-l determinize the automata on the fly, "
+	       << "-S <states> -M <MiB> -T <seconds> budget of a determinization, beyond which the automaton is "
+	       << "determinized on the fly (0: no limit; default: -M 1024), -h help" << endl;
 	}
       }
     } else {
-      // Read the input file (read_automata_file is implemented in parser.y)
-      automata |= read_lea_file(argv[i]);
-
+      inputs.push_back(argv[i]);
     }
   }
 
+  // Read the input files once all options are known (read_automata_file is implemented in parser.y)
+  for(char* input : inputs) {
+    automata |= read_lea_file(input);
+  }
+
     cout << automata << endl;
-  // Make additionnal verifications on the validity of the automata
+  // Make additionnal verifications on the validity of the automata; the automata that exceed the budget of the
+  // determinization are not determinized
   if(!check(automata)) {
     exit(1);
   }
 
+  // Freeze the automata into transition matrices, with states numbered from 0 in breadth-first order,
+  // or prepare them to be determinized on the fly if they are not deterministic
+  vector<compiled_dfa> compiled;
+  vector<lazy_dfa> lazy;
+  for(const automaton& a : automata) {
+    if(is_lazy(a)) lazy.emplace_back(a);
+    else compiled.emplace_back(a);
+  }
+
   // Generate c output
   ofstream file;
   file.open (output);
-  generate_c_file(file, automata);
+  generate_c_file(file, compiled, lazy);
   file.close();
 }
 
-bool check(set<automaton> automata) {
+bool is_lazy(const automaton& a) {
+  return lazy_automata || lazy_fallbacks.contains(string(a.name));
+}
+
+bool check(const set<automaton>& automata) {
   bool is_correct = true;
+  set<string, hash_policy<string>> names; // Names already seen, to find duplicates in linear time
   if(automata.size() == 0) {
     // Check that there are automata
     cerr << "erreur : aucun automate n'a été reconnu" << endl;
@@ -100,7 +220,7 @@ bool check(set<automaton> automata) {
   }
   for(size_t i = 0; i<automata.size(); ++i) {
     // Check that all automata are deterministic
-    if(!automata[i].is_deterministic()) {
+    if(!is_lazy(automata[i]) && !automata[i].is_deterministic()) {
       cerr << "erreur : l'automate " << automata[i].name << " n'est pas déterministe" << endl;
       is_correct = false;
     }
@@ -110,40 +230,179 @@ bool check(set<automaton> automata) {
       is_correct = false;
     }
     // Check that all automata have a different name
-    for(size_t j = i+1; j<automata.size(); ++j) {
-      if(automata[i].name == automata[j].name) {
-	cerr << "erreur : deux automates portent le nom " << automata[i].name << endl;
-	is_correct = false;
-      }
+    if(!names.insert(string(automata[i].name))) {
+      cerr << "erreur : deux automates portent le nom " << automata[i].name << endl;
+      is_correct = false;
     }
   }
   return is_correct;
 }
 
-void generate_c_file(ostream & out, set<automaton> automata) {
-  out   << "#include <stdio.h>\n\n"
+/*
+ * Gets the smallest unsigned c type whose size is width bytes
+ */
+static const char* c_type(size_t width) {
+  return width == 1 ? "unsigned char" : width == 2 ? "unsigned short" : "unsigned int";
+}
     
-        << "int main(int argc, char** argv){\n"
-	<< "  char c;\n\n"
+/*
+ * Functions of the generated program that determinize the lazy automata while reading
+ */
+static const char* lazy_runtime =
+  "// Automates déterminisés à la volée : les états de l'automate déterministe sont des ensembles d'états,\n"
+  "// calculés lors de leur première visite et gardés dans un cache borné, vidé lorsqu'il est plein\n"
+  "struct lazy_dfa {\n"
+  "  int words, classes, states, capacity;            // mots par ensemble, classes, états, taille du cache (puissance de 2)\n"
+  "  const unsigned int *offsets, *targets;          // successeurs de q par k : targets[offsets[q*classes+k] .. offsets[q*classes+k+1]-1]\n"
+  "  const unsigned long long *initials, *finals;\n"
+  "  unsigned long long *sets, *next_set, *current_set; // ensembles du cache, ensembles temporaires\n"
+  "  int *delta, *slots;                                // transitions du cache (-1 : inconnue), table de hachage (0 : libre)\n"
+  "  unsigned char* accepting;\n"
+  "  int size, current;\n"
+  "};\n\n"
+  "static int lazy_add(struct lazy_dfa* a, const unsigned long long* set) {\n"
+  "  unsigned long long h = 0x9e3779b97f4a7c15ULL;\n"
+  "  int mask = 2 * a->capacity - 1, i, k, id;\n"
+  "  for(k = 0; k < a->words; ++k) { h ^= set[k]; h *= 0xff51afd7ed558ccdULL; h ^= h >> 33; }\n"
+  "  for(i = (int)(h & mask); a->slots[i] != 0; i = (i + 1) & mask)\n"
+  "    if(memcmp(a->sets + (size_t)(a->slots[i] - 1) * a->words, set, a->words * sizeof(unsigned long long)) == 0) return a->slots[i] - 1;\n"
+  "  if(a->size == a->capacity) return -1;\n"
+  "  id = a->size++;\n"
+  "  memcpy(a->sets + (size_t)id * a->words, set, a->words * sizeof(unsigned long long));\n"
+  "  a->slots[i] = id + 1;\n"
+  "  for(k = 0; k < a->classes; ++k) a->delta[(size_t)id * a->classes + k] = -1;\n"
+  "  a->accepting[id] = 0;\n"
+  "  for(k = 0; k < a->words; ++k) if(set[k] & a->finals[k]) a->accepting[id] = 1;\n"
+  "  return id;\n"
+  "}\n\n"
+  "static void lazy_flush(struct lazy_dfa* a) {\n"
+  "  a->size = 0;\n"
+  "  memset(a->slots, 0, 2 * a->capacity * sizeof(int));\n"
+  "}\n\n"
+  "static void lazy_reset(struct lazy_dfa* a) {\n"
+  "  if((a->current = lazy_add(a, a->initials)) < 0) { lazy_flush(a); a->current = lazy_add(a, a->initials); }\n"
+  "}\n\n"
+  "static void lazy_read(struct lazy_dfa* a, int k) {\n"
+  "  int next = a->delta[(size_t)a->current * a->classes + k], q;\n"
+  "  unsigned int i;\n"
+  "  if(next < 0) {\n"
+  "    const unsigned long long* from = a->sets + (size_t)a->current * a->words;\n"
+  "    memset(a->next_set, 0, a->words * sizeof(unsigned long long));\n"
+  "    for(q = 0; q < a->states; ++q)\n"
+  "      if(from[q / 64] >> (q % 64) & 1)\n"
+  "        for(i = a->offsets[(size_t)q * a->classes + k]; i < a->offsets[(size_t)q * a->classes + k + 1]; ++i)\n"
+  "          a->next_set[a->targets[i] / 64] |= 1ULL << (a->targets[i] % 64);\n"
+  "    if((next = lazy_add(a, a->next_set)) < 0) {\n"
+  "      memcpy(a->current_set, from, a->words * sizeof(unsigned long long));\n"
+  "      lazy_flush(a);\n"
+  "      a->current = lazy_add(a, a->current_set);\n"
+  "      next = lazy_add(a, a->next_set);\n"
+  "    }\n"
+  "    a->delta[(size_t)a->current * a->classes + k] = next;\n"
+  "  }\n"
+  "  a->current = next;\n"
+  "}\n\n";
+
+/*
+ * Prints the words of the bitmap b, of the given number of words, separated by commas
+ */
+static void print_words(ostream& out, const bitset& b, size_t words) {
+  for(size_t i = 0; i < words; ++i)
+    out << (i ? "," : "") << (i < b.word_count() ? b.data()[i] : 0) << "ULL";
+}
+
+void generate_c_file(ostream & out, const vector<compiled_dfa>& automata, const vector<lazy_dfa>& lazy_automata) {
+  out   << "#include <stdio.h>\n"
+	<< "#include <string.h>\n\n";
+
+  for(const compiled_dfa& a : automata) {
+    const string& n = a.name();
+    out << "// Automate reconnaissant " << n << " : classes des caractères, transitions et états acceptants\n"
+	<< "static const unsigned char " << n << "_classes[256] = {";
+    for(int c = 0; c < 256; ++c) out << (c ? "," : "") << a.symbol_class((char)c);
+    out << "};\n"
+	<< "static const " << c_type(a.state_width()) << " " << n << "_delta[" << a.state_count() << "][" << a.class_count() << "] = {\n";
+    for(uint32_t q = 0; q < a.state_count(); ++q) {
+      out << "  {";
+      for(uint32_t k = 0; k < a.class_count(); ++k) out << (k ? "," : "") << a.next(q, k);
+      out << "},\n";
+    }
+    out << "};\n"
+	<< "static const unsigned char " << n << "_final[" << a.state_count() << "] = {";
+    for(uint32_t q = 0; q < a.state_count(); ++q) out << (q ? "," : "") << a.is_accepting(q);
+    out << "};\n\n";
+  }
+
+  if(!lazy_automata.empty()) out << lazy_runtime;
+  for(const lazy_dfa& a : lazy_automata) {
+    const string& n = a.name();
+    size_t words = (a.state_count() + 63) / 64, capacity = 2;
+    while(2 * capacity <= a.cache_capacity()) capacity *= 2;
+    // The successors are listed, and only turned into bitmaps by the generated program: the file grows with the
+    // transitions of the automaton, not with its number of states squared
+    vector<size_t> offsets(1, 0);
+    vector<int> targets;
+    for(uint32_t q = 0; q < a.state_count(); ++q)
+      for(uint32_t k = 0; k < a.class_count(); ++k) {
+	for(int r : a.successors(q, k)) targets.push_back(r);
+	offsets.push_back(targets.size());
+      }
+    out << "// Automate reconnaissant " << n << " : classes des caractères, successeurs de chaque état par chaque classe, états initiaux et finaux\n"
+	<< "static const unsigned char " << n << "_classes[256] = {";
+    for(int c = 0; c < 256; ++c) out << (c ? "," : "") << a.symbol_class((char)c);
+    out << "};\n"
+	<< "static const unsigned int " << n << "_offsets[" << offsets.size() << "] = {";
+    for(size_t i = 0; i < offsets.size(); ++i) out << (i ? "," : "") << offsets[i];
+    out << "};\n"
+	<< "static const unsigned int " << n << "_targets[" << max<size_t>(targets.size(), 1) << "] = {";
+    for(size_t i = 0; i < targets.size(); ++i) out << (i ? "," : "") << targets[i];
+    if(targets.empty()) out << 0; // A C array cannot be empty
+    out << "};\n"
+	<< "static const unsigned long long " << n << "_initials[" << words << "] = {";
+    print_words(out, a.initials(), words);
+    out << "};\n"
+	<< "static const unsigned long long " << n << "_finals[" << words << "] = {";
+    print_words(out, a.finals(), words);
+    out << "};\n"
+	<< "static unsigned long long " << n << "_sets[" << capacity * words << "], " << n << "_temporary[" << 2 * words << "];\n"
+	<< "static int " << n << "_delta[" << capacity * a.class_count() << "], " << n << "_slots[" << 2 * capacity << "];\n"
+	<< "static unsigned char " << n << "_accepting[" << capacity << "];\n"
+	<< "static struct lazy_dfa " << n << " = {" << words << ", " << a.class_count() << ", " << a.state_count() << ", " << capacity << ", "
+	<< n << "_offsets, " << n << "_targets, " << n << "_initials, " << n << "_finals, " << n << "_sets, " << n << "_temporary, " << n << "_temporary + " << words << ", "
+	<< n << "_delta, " << n << "_slots, " << n << "_accepting, 0, 0};\n\n";
+  }
+
+  out   << "int main(int argc, char** argv){\n"
+	<< "  int c;\n\n"
     
 	<< "  // États internes des automates\n";
-  for(automaton a : automata)
-    out << "  int " << a.name << "=" << a.initials[0] << ";\n";
+  for(const compiled_dfa& a : automata)
+    out << "  int " << a.name() << "=" << a.initial() << ";\n";
+  for(const lazy_dfa& a : lazy_automata)
+    out << "  lazy_reset(&" << a.name() << ");\n";
   out   << "  \n"
 	<< "  while((c = fgetc(stdin)) != EOF) {\n\n";
 
-  for(automaton a : automata){
-
-    out << "    // Automate reconnaissant "<< a.name <<"\n"
-	<< "    if (c == '\\n'"; for(int f:a.finals)out<<" && "<<a.name<<"!="<<f; out << ")\tprintf(\"non \");\n"
-	<< "    if (c == '\\n')\t\t{printf(\"reconnu par " << a.name << "\\n\"); " << a.name << " = " << a.initials[0] << ";}\n";
-    for(transition t : a.transitions)
-      out<<"    else if(" << a.name << "==" << t.start << " && c=='" << t.terminal <<"')\t" << a.name << " = " << t.end << ";\n";
-    out << "    else if(c!=' ' && c!='\\t')\t" << a.name << " = -1;\n\n";
+  // The automata are run in the order of their names, whatever their backend
+  size_t i = 0, j = 0;
+  while(i < automata.size() || j < lazy_automata.size()) {
+    if(j == lazy_automata.size() || (i < automata.size() && automata[i].name() < lazy_automata[j].name())) {
+      const compiled_dfa& a = automata[i++];
+      const string& n = a.name();
+      out << "    // Automate reconnaissant "<< n <<"\n"
+	  << "    if (c == '\\n' && !" << n << "_final[" << n << "])\tprintf(\"non \");\n"
+	  << "    if (c == '\\n')\t\t{printf(\"reconnu par " << n << "\\n\"); " << n << " = " << a.initial() << ";}\n"
+	  << "    else if(" << n << "_classes[c] != 0 || (c!=' ' && c!='\\t'))\t" << n << " = " << n << "_delta[" << n << "][" << n << "_classes[c]];\n\n";
+    } else {
+      const string& n = lazy_automata[j++].name();
+      out << "    // Automate reconnaissant "<< n <<", déterminisé à la volée\n"
+	  << "    if (c == '\\n' && !" << n << ".accepting[" << n << ".current])\tprintf(\"non \");\n"
+	  << "    if (c == '\\n')\t\t{printf(\"reconnu par " << n << "\\n\"); lazy_reset(&" << n << ");}\n"
+	  << "    else if(" << n << "_classes[c] != 0 || (c!=' ' && c!='\\t'))\tlazy_read(&" << n << ", " << n << "_classes[c]);\n\n";
+    }
   }
 
   out   << "  }\n"
 	<< "  return 0;\n"
 	<< "}\n";
 }
-
@@ -0,0 +1,335 @@
+/**
+ * \file minimize.cpp
+ * \brief Implementation file containing the code of the minimization of automata
+ */
+
+#include "automaton.hpp"
+#include "compiled_dfa.hpp"
+#include <vector>
+
+using namespace univ_nantes;
+
+namespace {
+
+  /**
+   * \class partition
+   * \brief Partition of the elements {0, ..., n-1} into blocks, that can be split in time proportional to the elements marked
+   *
+   * The elements are stored in an array, in which each block is a contiguous range [first, end). The marked elements of a
+   * block are moved to the beginning of its range, up to mid; splitting the block separates the marked elements from the
+   * others. The smaller of the two parts always gets the new block number, so that the blocks numbered from some b upwards
+   * are exactly those that still have to be used as splitters, as in Hopcroft's "process the smaller half" rule.
+   */
+  class partition {
+  private:
+    std::vector<std::uint32_t> elements;        /*!< Elements, grouped by block. */
+    std::vector<std::uint32_t> location;        /*!< location[e] is the position of e in elements. */
+    std::vector<std::uint32_t> block;           /*!< block[e] is the block of e. */
+    std::vector<std::uint32_t> first, mid, end; /*!< Range of each block, and end of its marked elements. */
+    std::vector<std::uint32_t> touched;         /*!< Blocks with marked elements. */
+
+  public:
+    /**
+     * \fn explicit partition(std::uint32_t n)
+     * \brief Creates the partition of {0, ..., n-1} with a single block 0, or no block if n is 0
+     */
+    explicit partition(std::uint32_t n) : elements(n), location(n), block(n, 0) {
+      for(std::uint32_t e = 0; e < n; ++e)
+	elements[e] = location[e] = e;
+      if(n > 0) {
+	first.push_back(0);
+	mid.push_back(0);
+	end.push_back(n);
+      }
+    }
+
+    std::uint32_t size() const { return first.size(); }
+    std::uint32_t block_of(std::uint32_t e) const { return block[e]; }
+    const std::uint32_t* begin(std::uint32_t b) const { return elements.data() + first[b]; }
+    const std::uint32_t* end_of(std::uint32_t b) const { return elements.data() + end[b]; }
+
+    /**
+     * \fn void mark(std::uint32_t e)
+     * \brief Marks e, if it is not marked yet
+     */
+    void mark(std::uint32_t e) {
+      std::uint32_t b = block[e], i = location[e];
+      if(i < mid[b]) return;
+      if(mid[b] == first[b]) touched.push_back(b);
+      std::uint32_t other = elements[mid[b]];
+      std::swap(elements[i], elements[mid[b]]);
+      location[other] = i;
+      location[e] = mid[b]++;
+    }
+
+    /**
+     * \fn void split()
+     * \brief Splits each block that has both marked and unmarked elements, and unmarks all elements
+     *
+     * The smaller part of a split block gets a new block number, the larger part keeps the number of the block.
+     */
+    void split() {
+      for(std::uint32_t b : touched) {
+	std::uint32_t m = mid[b];
+	mid[b] = first[b];
+	if(m == end[b]) continue;
+	std::uint32_t nb = first.size();
+	if(m - first[b] <= end[b] - m) {
+	  first.push_back(first[b]);
+	  end.push_back(m);
+	  first[b] = m;
+	} else {
+	  first.push_back(m);
+	  end.push_back(end[b]);
+	  end[b] = m;
+	}
+	mid.push_back(first[nb]);
+	mid[b] = first[b];
+	for(std::uint32_t i = first[nb]; i < end[nb]; ++i)
+	  block[elements[i]] = nb;
+      }
+      touched.clear();
+    }
+  };
+
+  /**
+   * \fn bool try_determinized(const automaton& a, const determinization_budget& budget, unsigned threads, automaton& result)
+   * \brief Gets a trim deterministic automaton recognizing the language of a, determinizing it only if needed, within budget
+   * \return false if the determinization exceeds the budget
+   */
+  bool try_determinized(const automaton& a, const determinization_budget& budget, unsigned threads, automaton& result) {
+    if(!a.is_deterministic()) return a.try_determine(budget, result, threads);
+    result = a.trim();
+    return true;
+  }
+
+  /**
+   * \fn automaton quotient(const automaton& dfa, const partition& blocks)
+   * \brief Gets the automaton whose states are the blocks of the states of dfa
+   */
+  automaton quotient(const automaton& dfa, const partition& blocks) {
+    automaton result;
+    result.initials |= (int)blocks.block_of(dfa.initials[0]);
+    set<int>::builder finals;
+    for(int f : dfa.finals)
+      finals.add(blocks.block_of(f));
+    set<transition>::builder transitions;
+    transitions.reserve(dfa.transitions.size());
+    for(const transition& t : dfa.transitions)
+      transitions.add(transition(blocks.block_of(t.start), t.terminal, blocks.block_of(t.end)));
+    result.finals = finals.build();
+    result.transitions = transitions.build();
+    return result;
+  }
+
+  /**
+   * \fn automaton hopcroft(const automaton& a)
+   * \brief Minimizes the deterministic automaton a by Hopcroft's algorithm
+   *
+   * The automaton is frozen into a compiled_dfa, which numbers the states from 0, completes the transitions with a sink
+   * state, and groups the symbols into classes. The partition starts with the accepting and the other states. Each
+   * splitter block S splits the blocks into the states that have a transition to S for a given class of symbols, and
+   * the others. The block of the sink gathers the states from which no final state is reachable: it is removed.
+   */
+  automaton hopcroft(const automaton& a) {
+    compiled_dfa dfa(a);
+    std::uint32_t n = dfa.state_count(), classes = dfa.class_count();
+
+    // Predecessors of each state by each class: inverse[inverse_first[k*n + r] ..] are the states q with next(q, k) = r
+    std::vector<std::uint32_t> inverse_first((std::size_t)classes * n + 1, 0), inverse((std::size_t)classes * n);
+    for(std::uint32_t k = 0; k < classes; ++k)
+      for(std::uint32_t q = 0; q < n; ++q)
+	++inverse_first[(std::size_t)k * n + dfa.next(q, k) + 1];
+    for(std::size_t i = 0; i + 1 < inverse_first.size(); ++i)
+      inverse_first[i + 1] += inverse_first[i];
+    std::vector<std::uint32_t> fill(inverse_first.begin(), inverse_first.end() - 1);
+    for(std::uint32_t k = 0; k < classes; ++k)
+      for(std::uint32_t q = 0; q < n; ++q)
+	inverse[fill[(std::size_t)k * n + dfa.next(q, k)]++] = q;
+
+    partition p(n);
+    for(std::uint32_t q = 0; q < n; ++q)
+      if(dfa.is_accepting(q)) p.mark(q);
+    p.split();
+
+    // The blocks from s upwards form the worklist: block 0 is the larger initial block, and is not needed as a splitter
+    std::vector<std::uint32_t> splitter;
+    for(std::uint32_t s = 1; s < p.size(); ++s) {
+      splitter.assign(p.begin(s), p.end_of(s)); // s itself may be split below
+      // Class 0 leads every state to the sink, so it never splits a block
+      for(std::uint32_t k = 1; k < classes; ++k) {
+	for(std::uint32_t r : splitter)
+	  for(std::uint32_t i = inverse_first[(std::size_t)k * n + r]; i < inverse_first[(std::size_t)k * n + r + 1]; ++i)
+	    p.mark(inverse[i]);
+	p.split();
+      }
+    }
+
+    // The block of the sink is removed, unless it contains the initial state, in which case the language is empty
+    std::uint32_t dead = p.block_of(dfa.sink());
+    bool empty_language = p.block_of(dfa.initial()) == dead;
+    automaton result;
+    result.initials |= (int)p.block_of(dfa.initial());
+    std::vector<bool> done(p.size(), false);
+    set<int>::builder finals;
+    set<transition>::builder transitions;
+    for(std::uint32_t q = 0; q < n; ++q) {
+      std::uint32_t b = p.block_of(q);
+      if(done[b] || (b == dead && !empty_language)) continue;
+      done[b] = true;
+      if(dfa.is_accepting(q)) finals.add(b);
+      if(empty_language) continue;
+      for(int c = 1; c < 256; ++c) {
+	std::uint32_t k = dfa.symbol_class((char)c);
+	if(k != 0 && p.block_of(dfa.next(q, k)) != dead)
+	  transitions.add(transition(b, (char)c, p.block_of(dfa.next(q, k))));
+      }
+    }
+    result.finals = finals.build();
+    result.transitions = transitions.build();
+    return result.trim(); // Hopcroft's algorithm keeps the states that are not accessible
+  }
+
+  /**
+   * \fn automaton valmari(const automaton& a)
+   * \brief Minimizes the deterministic automaton a by the algorithm of Valmari and Lehtinen
+   *
+   * The transitions are partitioned together with the states: a block of transitions (a "cord") contains transitions
+   * with the same label, whose end states are in the same block. Each new block of states splits the cords by the
+   * transitions that enter it, and each new cord splits the blocks of states by the start states of its transitions.
+   * Only the transitions of the automaton are visited, so a partial automaton is not completed, and the cost is
+   * O(m.log n) for m transitions and n states, whatever the size of the alphabet.
+   */
+  automaton valmari(const automaton& a) {
+    automaton dfa = a.trim(); // The algorithm requires all states to be accessible and co-accessible
+    dfa.compact();
+    std::uint32_t n = dfa.get_states().size(), m = dfa.transitions.size();
+    std::vector<std::uint32_t> start(m), end(m);
+    std::vector<unsigned char> label(m);
+    std::vector<std::uint32_t> entering_first(n + 1, 0), entering(m);
+    std::vector<std::uint32_t> label_first(257, 0), by_label(m);
+    for(std::uint32_t t = 0; t < m; ++t) {
+      const transition& tr = dfa.transitions[t];
+      start[t] = tr.start;
+      end[t] = tr.end;
+      label[t] = (unsigned char)tr.terminal;
+      ++entering_first[end[t] + 1];
+      ++label_first[label[t] + 1];
+    }
+    for(std::uint32_t q = 0; q < n; ++q)
+      entering_first[q + 1] += entering_first[q];
+    for(int c = 0; c < 256; ++c)
+      label_first[c + 1] += label_first[c];
+    std::vector<std::uint32_t> fill_entering(entering_first.begin(), entering_first.end() - 1);
+    std::vector<std::uint32_t> fill_label(label_first.begin(), label_first.end() - 1);
+    for(std::uint32_t t = 0; t < m; ++t) {
+      entering[fill_entering[end[t]]++] = t;
+      by_label[fill_label[label[t]]++] = t;
+    }
+
+    partition blocks(n);
+    for(int f : dfa.finals)
+      blocks.mark(f);
+    blocks.split();
+
+    partition cords(m);
+    for(int c = 0; c < 256; ++c) {
+      for(std::uint32_t i = label_first[c]; i < label_first[c + 1]; ++i)
+	cords.mark(by_label[i]);
+      cords.split();
+    }
+
+    // Block 0 of the states is the larger initial block, and is not needed as a splitter
+    std::uint32_t b = 1, c = 0;
+    while(c < cords.size()) {
+      for(const std::uint32_t* t = cords.begin(c); t != cords.end_of(c); ++t)
+	blocks.mark(start[*t]);
+      blocks.split();
+      ++c;
+      for(; b < blocks.size(); ++b) {
+	for(const std::uint32_t* q = blocks.begin(b); q != blocks.end_of(b); ++q)
+	  for(std::uint32_t i = entering_first[*q]; i < entering_first[*q + 1]; ++i)
+	    cords.mark(entering[i]);
+	cords.split();
+      }
+    }
+    return quotient(dfa, blocks);
+  }
+
+  /**
+   * \fn bool brzozowski(const automaton& a, const determinization_budget& budget, unsigned threads, automaton& result)
+   * \brief Minimizes a by Brzozowski's algorithm, if both determinizations fit in budget
+   *
+   * Determinizing the reverse of an automaton whose states are all accessible gives a minimal automaton. Applied twice,
+   * this gives the minimal automaton of the language, without determinizing a itself: the first determinization works on
+   * the reversed automaton, which can be much smaller for the automata of rational expressions of the parser.
+   */
+  bool brzozowski(const automaton& a, const determinization_budget& budget, unsigned threads, automaton& result) {
+    automaton reversed;
+    return try_determinized(a.reverse(), budget, threads, reversed)
+      && try_determinized(reversed.reverse(), budget, threads, result);
+  }
+
+}
+
+/*
+ * Gets an automaton that recognizes the mirror of the language
+ */
+automaton automaton::reverse() const {
+  automaton result;
+  result.name = name;
+  result.initials = finals;
+  result.finals = initials;
+  set<transition>::builder reversed;
+  reversed.reserve(transitions.size());
+  for(const transition& t : transitions)
+    reversed.add(transition(t.end, t.terminal, t.start));
+  result.transitions = reversed.build();
+  return result;
+}
+
+/*
+ * Gets the minimal deterministic automaton that recognizes the same language, with the given algorithm
+ *
+ * The algorithm of the automatic strategy is given by chosen_minimization().
+ */
+automaton automaton::minimize(minimization strategy) const {
+  automaton result; // Without limits, the minimization always succeeds
+  try_minimize(strategy, determinization_budget(), result);
+  return result;
+}
+
+/*
+ * Same as minimize(), but gives up as soon as one of the determinizations exceeds the budget
+ */
+bool automaton::try_minimize(minimization strategy, const determinization_budget& budget, automaton& result, unsigned threads) const {
+  strategy = chosen_minimization(strategy);
+  automaton minimal;
+  if(strategy == minimization::brzozowski) {
+    if(!brzozowski(*this, budget, threads, minimal)) return false;
+  } else {
+    automaton dfa;
+    if(!try_determinized(*this, budget, threads, dfa)) return false;
+    minimal = strategy == minimization::valmari ? valmari(dfa) : hopcroft(dfa);
+  }
+  minimal.name = name;
+  minimal.compact();
+  result = std::move(minimal);
+  return true;
+}
+
+/*
+ * Gets the algorithm run by minimize(strategy)
+ *
+ * On the automata of bench/minimize.cpp, the algorithm of Valmari and Lehtinen was as fast as Hopcroft's algorithm on
+ * random complete automata over 3 symbols, and twice faster on partial automata over 90 symbols, from 100 to 50000
+ * states; Brzozowski's algorithm exceeded its budget on most of them. On non-deterministic automata, Brzozowski's
+ * algorithm was 2000 times faster on (a|b|c)*a(a|b|c)^14|(a|b|c)*, whose determinization explodes but not the one of
+ * its reverse, and 8000 times slower on (a|b|c)^14a(a|b|c)*, where it is the reverse; comparing the two estimates
+ * told these cases apart.
+ */
+minimization automaton::chosen_minimization(minimization strategy) const {
+  if(strategy != minimization::automatic) return strategy;
+  if(is_deterministic() || estimated_dfa_states() <= reverse().estimated_dfa_states()) return minimization::valmari;
+  return minimization::brzozowski;
+}
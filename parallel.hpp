@@ -0,0 +1,66 @@
+#ifndef PARALLEL_HPP_DEFINED
+#define PARALLEL_HPP_DEFINED
+
+/**
+ * \file parallel.hpp
+ * \brief Header file containing the declaration of parallel_for, which spreads the iterations of a loop over threads.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace univ_nantes {
+
+  /**
+   * \fn unsigned thread_count(unsigned requested)
+   * \brief Gets the number of threads to use: requested, or the number of hardware threads if requested is 0
+   */
+  inline unsigned thread_count(unsigned requested) {
+    if(requested > 0) return requested;
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+  }
+
+  /**
+   * \fn void parallel_for(unsigned threads, std::uint32_t begin, std::uint32_t end, F body)
+   * \brief Calls body(i) for each i in [begin, end), on up to threads threads
+   *
+   * The iterations are handed out by chunks taken from a shared counter, so that a thread that gets cheap
+   * iterations takes more of them. The calling thread takes part in the work, and the function returns when all
+   * iterations are done. The calls to body must be independent: they can run in any order, and concurrently.
+   * With a single thread, or a single chunk, the loop simply runs in the calling thread.
+   */
+  template<typename F>
+  void parallel_for(unsigned threads, std::uint32_t begin, std::uint32_t end, F body) {
+    const std::uint32_t chunk = 16;
+    if(end <= begin) return;
+    std::uint32_t chunks = (end - begin + chunk - 1) / chunk;
+    threads = std::min<std::uint32_t>(threads, chunks);
+    if(threads <= 1) {
+      for(std::uint32_t i = begin; i < end; ++i) body(i);
+      return;
+    }
+    std::atomic<std::uint32_t> next(begin);
+    auto work = [&]() {
+      for(;;) {
+	std::uint32_t first = next.fetch_add(chunk);
+	if(first >= end) return;
+	std::uint32_t last = std::min(end, first + chunk);
+	for(std::uint32_t i = first; i < last; ++i) body(i);
+      }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for(unsigned t = 1; t < threads; ++t)
+      workers.emplace_back(work);
+    work();
+    for(std::thread& worker : workers)
+      worker.join();
+  }
+
+}
+
+#endif // PARALLEL_HPP_DEFINED
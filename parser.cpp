@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,17 +67,18 @@
 
 
 /* First part of user prologue.  */
-#line 1 "parser.yxx"
+#line 9 "parser.yxx"
 
 
 #include "automaton.hpp"
 #include "set.hpp"
+#include "arena.hpp"
+#include <memory>
 #include <string>
+#include <vector>
 
 using namespace univ_nantes;
 
-#define YYSTYPE automaton
-extern YYSTYPE yylval;
 extern char* yyid;
 
 extern FILE *yyin;
@@ -92,14 +94,99 @@ extern int previous_non_terminal;
 // value of the last identifier that was observed by the lexer
 extern std::string identifier;
 
-// The set of automata that were already parsed
-set<automaton> automata;
+// The set of automata that were already parsed, in the file being read
+set<automaton>* automata = nullptr;
 
 // Variable used to generate states whenever needed
 int new_state=0;
 
+// Automata built while parsing the current automaton, pointed to by the semantic values
+std::vector<std::unique_ptr<automaton>> values;
+
+// Arena in which the values of the current automaton are allocated, released after each automaton (see read_lea_file)
+arena_scope* values_arena = nullptr;
+
+// Gets a new empty automaton, owned by values, to use as a semantic value
+automaton* new_value() {
+  values.push_back(std::make_unique<automaton>());
+  return values.back().get();
+}
+
+// Whether the automata are minimized after their determinization (disabled by the option -n of lea)
+bool minimize_automata = true;
+
+// Algorithm used to minimize the automata (chosen by the option -m of lea)
+minimization minimization_strategy = minimization::automatic;
+
+// Number of threads used by the determinization, 0 for all hardware threads (chosen by the option -j of lea)
+unsigned determinization_threads = 1;
+
+// Whether the automata are kept as they are, to be determinized on the fly (chosen by the option -l of lea)
+bool lazy_automata = false;
+
+// Limits of the determinization (options -S, -M and -T of lea): an automaton whose determinization exceeds them
+// is kept non-deterministic, and determinized on the fly by the lazy backend
+determinization_budget determinization_limits = { 0, 1024 * 1024 * 1024, 0 };
+
+// Names of the non-deterministic automata whose determinization exceeded determinization_limits: they are kept as
+// they are, and only them are sent to the lazy backend unless the option -l of lea is given
+set<std::string> lazy_fallbacks;
+
+// Gets whether an automaton whose determinization has at most estimate states certainly fits in determinization_limits:
+// beyond max_states states, or if the transitions that lead to the states alone would exceed max_bytes, it does not
+bool within_limits(double estimate) {
+  return (determinization_limits.max_states == 0 || estimate <= determinization_limits.max_states)
+    && (determinization_limits.max_bytes == 0 || estimate * sizeof(transition) <= determinization_limits.max_bytes);
+}
+
+// Gets a as it is, once its determinization exceeded determinization_limits: it is recorded in lazy_fallbacks, unless it
+// is already deterministic and can be compiled as it is
+automaton keep_for_lazy_backend(const automaton& a) {
+  if(!a.is_deterministic()) lazy_fallbacks |= identifier;
+  return a;
+}
+
+// Determinizes a within determinization_limits, then minimizes it if minimize_automata is set and prints the number
+// of states before and after; a is returned as it is if the determinization exceeds its budget
+automaton determine_and_minimize(const automaton& a) {
+  if(lazy_automata) return a;
+  // Brzozowski's algorithm does not determinize a itself, but its reverse first; its determinizations are limited by the
+  // budget too, so it does not need the determinized automaton. The automatic strategy is resolved on a, which is not
+  // deterministic yet
+  minimization strategy = minimize_automata ? a.chosen_minimization(minimization_strategy) : minimization_strategy;
+  bool brzozowski = minimize_automata && strategy == minimization::brzozowski;
+  // The estimate is cheap: an explosion is announced, and avoided, before the determinization starts
+  double estimate = (brzozowski ? a.reverse() : a).estimated_dfa_states();
+  if(!within_limits(estimate)) {
+    std::cout << "Risque d'explosion pour " << identifier << " : jusqu'a " << estimate << " etats, l'automate sera determinise a la volee" << std::endl;
+    return keep_for_lazy_backend(a);
+  }
+  automaton dfa = a, minimal;
+  if((!brzozowski && !a.try_determine(determinization_limits, dfa, determinization_threads))
+     || (minimize_automata && !dfa.try_minimize(strategy, determinization_limits, minimal, determinization_threads))) {
+    std::cout << "Budget de determinisation depasse pour " << identifier << " : l'automate sera determinise a la volee" << std::endl;
+    return keep_for_lazy_backend(a);
+  }
+  if(!minimize_automata) return dfa;
+  std::cout << "Minimisation de " << identifier << " : " << dfa.get_states().size() << " etats -> "
+	    << minimal.get_states().size() << " etats" << std::endl;
+  return minimal;
+}
+
+// Adds the automaton a, once determinized and minimized, to the parsed automata under the last identifier;
+// the values built to parse it are no longer needed, and their arena is released
+void add_automaton(const automaton& a) {
+  {
+    automaton result = determine_and_minimize(a);
+    result.name = identifier;
+    *automata |= values_arena->copy_out(result);
+  }
+  values.clear();
+  values_arena->release();
+}
+
 
-#line 103 "parser.cpp"
+#line 190 "parser.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -122,64 +209,40 @@ int new_state=0;
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_PARSER_HPP_INCLUDED
-# define YY_YY_PARSER_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    AUTOMATE_KW = 258,
-    INITIAL_KW = 259,
-    FINAL_KW = 260,
-    SEMICOLON = 261,
-    EQUAL = 262,
-    OR = 263,
-    STAR = 264,
-    PLUS = 265,
-    L_PAR = 266,
-    R_PAR = 267,
-    L_BRACE = 268,
-    R_BRACE = 269,
-    L_TRANS = 270,
-    R_TRANS = 271,
-    IDENTIFIER = 272,
-    TERMINAL = 273,
-    NONTERMINAL = 274
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef int YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
-
-extern YYSTYPE yylval;
-
-int yyparse (void);
+#include "parser.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_AUTOMATE_KW = 3,                /* AUTOMATE_KW  */
+  YYSYMBOL_INITIAL_KW = 4,                 /* INITIAL_KW  */
+  YYSYMBOL_FINAL_KW = 5,                   /* FINAL_KW  */
+  YYSYMBOL_SEMICOLON = 6,                  /* SEMICOLON  */
+  YYSYMBOL_EQUAL = 7,                      /* EQUAL  */
+  YYSYMBOL_OR = 8,                         /* OR  */
+  YYSYMBOL_STAR = 9,                       /* STAR  */
+  YYSYMBOL_PLUS = 10,                      /* PLUS  */
+  YYSYMBOL_L_PAR = 11,                     /* L_PAR  */
+  YYSYMBOL_R_PAR = 12,                     /* R_PAR  */
+  YYSYMBOL_L_BRACE = 13,                   /* L_BRACE  */
+  YYSYMBOL_R_BRACE = 14,                   /* R_BRACE  */
+  YYSYMBOL_L_TRANS = 15,                   /* L_TRANS  */
+  YYSYMBOL_R_TRANS = 16,                   /* R_TRANS  */
+  YYSYMBOL_IDENTIFIER = 17,                /* IDENTIFIER  */
+  YYSYMBOL_TERMINAL = 18,                  /* TERMINAL  */
+  YYSYMBOL_NONTERMINAL = 19,               /* NONTERMINAL  */
+  YYSYMBOL_YYACCEPT = 20,                  /* $accept  */
+  YYSYMBOL_input = 21,                     /* input  */
+  YYSYMBOL_automaton = 22,                 /* automaton  */
+  YYSYMBOL_automaton_fields = 23,          /* automaton_fields  */
+  YYSYMBOL_rationnal = 24,                 /* rationnal  */
+  YYSYMBOL_rationnal_rules = 25            /* rationnal_rules  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-#endif /* !YY_YY_PARSER_HPP_INCLUDED  */
 
 
 
@@ -220,6 +283,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -279,6 +354,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_int8 yy_state_t;
 
@@ -297,6 +373,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -315,17 +392,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -354,7 +437,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -419,8 +502,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -496,14 +578,16 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  38
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   274
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -540,37 +624,40 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_int8 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_uint8 yyrline[] =
 {
-       0,    47,    47,    48,    49,    53,    56,    59,    61,    63,
-      65,    70,    79,    80,    81,    82,    83,    84,    85,    88,
-      89
+       0,   141,   141,   142,   143,   147,   152,   154,   156,   158,
+     160,   165,   174,   175,   176,   177,   178,   179,   180,   183,
+     184
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "AUTOMATE_KW", "INITIAL_KW", "FINAL_KW",
-  "SEMICOLON", "EQUAL", "OR", "STAR", "PLUS", "L_PAR", "R_PAR", "L_BRACE",
-  "R_BRACE", "L_TRANS", "R_TRANS", "IDENTIFIER", "TERMINAL", "NONTERMINAL",
-  "$accept", "input", "automaton", "automaton_fields", "rationnal",
-  "rationnal_rules", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "AUTOMATE_KW",
+  "INITIAL_KW", "FINAL_KW", "SEMICOLON", "EQUAL", "OR", "STAR", "PLUS",
+  "L_PAR", "R_PAR", "L_BRACE", "R_BRACE", "L_TRANS", "R_TRANS",
+  "IDENTIFIER", "TERMINAL", "NONTERMINAL", "$accept", "input", "automaton",
+  "automaton_fields", "rationnal", "rationnal_rules", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
 #define YYPACT_NINF (-11)
 
@@ -582,8 +669,8 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
      -11,     0,   -11,     2,   -11,   -11,   -10,   -11,   -11,     4,
@@ -592,9 +679,9 @@ static const yytype_int8 yypact[] =
       22,   -11,   -11,    34,    23,   -11,    35,   -11
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        2,     0,     1,     0,     3,     4,    12,     6,    13,     0,
@@ -603,21 +690,21 @@ static const yytype_int8 yydefact[] =
        0,    20,    19,     0,     0,    10,     0,     9
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -11,   -11,   -11,   -11,   -11,    -8
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     1,     4,    10,     5,     9
+       0,     1,     4,    10,     5,     9
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
        2,    17,    18,     7,    21,    31,    32,    22,     8,     6,
@@ -636,8 +723,8 @@ static const yytype_int8 yycheck[] =
        6,     6,    19
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,    21,     0,    17,    22,    24,     7,    13,    18,    25,
@@ -646,7 +733,7 @@ static const yytype_int8 yystos[] =
       18,     9,    10,    19,    16,     6,    19,     6
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    20,    21,    21,    21,    22,    23,    23,    23,    23,
@@ -654,7 +741,7 @@ static const yytype_int8 yyr1[] =
       25
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     0,     2,     2,     5,     0,     4,     4,     7,
@@ -663,14 +750,15 @@ static const yytype_int8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -692,10 +780,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -712,19 +799,16 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -735,18 +819,15 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -756,12 +837,13 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yytype, yyvaluep);
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
   YYFPRINTF (yyo, ")");
 }
 
@@ -794,7 +876,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -806,9 +889,8 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -823,8 +905,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -847,259 +929,30 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
-/* Return the length of YYSTR.  */
-static YYPTRDIFF_T
-yystrlen (const char *yystr)
-{
-  YYPTRDIFF_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYPTRDIFF_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYPTRDIFF_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            else
-              goto append;
-
-          append:
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
-
-  if (yyres)
-    return yystpcpy (yyres, yystr) - yyres;
-  else
-    return yystrlen (yystr);
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
-{
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Actual size of YYARG. */
-  int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-    default: /* Avoid compiler warnings. */
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          ++yyp;
-          ++yyformat;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
@@ -1108,6 +961,8 @@ YYSTYPE yylval;
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1115,43 +970,36 @@ int yynerrs;
 int
 yyparse (void)
 {
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
-
-    YYPTRDIFF_T yystacksize;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1159,16 +1007,10 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
 
@@ -1190,10 +1032,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1221,7 +1064,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1232,10 +1075,10 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1254,6 +1097,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1274,18 +1118,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1354,100 +1209,106 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 5:
-#line 53 "parser.yxx"
-                                                               {yyval = yyvsp[-1].determine(); yyval.name = identifier; automata |= yyval;}
-#line 1361 "parser.cpp"
+  case 5: /* automaton: IDENTIFIER EQUAL L_BRACE automaton_fields R_BRACE  */
+#line 147 "parser.yxx"
+                                                               {add_automaton(*yyvsp[-1]);}
+#line 1216 "parser.cpp"
     break;
 
-  case 7:
-#line 59 "parser.yxx"
-                                                                              {yyval = yyvsp[-3]; yyval.initials |= non_terminal;}
-#line 1367 "parser.cpp"
+  case 6: /* automaton_fields: %empty  */
+#line 152 "parser.yxx"
+                                                                              {yyval = new_value();}
+#line 1222 "parser.cpp"
     break;
 
-  case 8:
-#line 61 "parser.yxx"
-                                                                              {yyval = yyvsp[-3]; yyval.finals |= non_terminal;}
-#line 1373 "parser.cpp"
+  case 7: /* automaton_fields: automaton_fields INITIAL_KW NONTERMINAL SEMICOLON  */
+#line 154 "parser.yxx"
+                                                                              {yyval->initials |= non_terminal;}
+#line 1228 "parser.cpp"
     break;
 
-  case 9:
-#line 63 "parser.yxx"
-                                                                              {yyval = yyvsp[-6]; yyval.transitions |= transition(previous_non_terminal, terminal, non_terminal);}
-#line 1379 "parser.cpp"
+  case 8: /* automaton_fields: automaton_fields FINAL_KW NONTERMINAL SEMICOLON  */
+#line 156 "parser.yxx"
+                                                                              {yyval->finals |= non_terminal;}
+#line 1234 "parser.cpp"
     break;
 
-  case 10:
-#line 65 "parser.yxx"
-                                                                              {yyval = yyvsp[-5]; yyval.transitions |= transition(previous_non_terminal, non_terminal);}
-#line 1385 "parser.cpp"
+  case 9: /* automaton_fields: automaton_fields NONTERMINAL L_TRANS TERMINAL R_TRANS NONTERMINAL SEMICOLON  */
+#line 158 "parser.yxx"
+                                                                              {yyval->transitions.emplace(previous_non_terminal, terminal, non_terminal);}
+#line 1240 "parser.cpp"
     break;
 
-  case 11:
-#line 70 "parser.yxx"
-                                                      {std::cout << yyvsp[-1] << std::endl;yyval = yyvsp[-1].determine(); yyval.name = identifier; automata |= yyval;}
-#line 1391 "parser.cpp"
+  case 10: /* automaton_fields: automaton_fields NONTERMINAL L_TRANS R_TRANS NONTERMINAL SEMICOLON  */
+#line 160 "parser.yxx"
+                                                                              {yyval->transitions.emplace(previous_non_terminal, non_terminal);}
+#line 1246 "parser.cpp"
     break;
 
-  case 12:
-#line 79 "parser.yxx"
-                                                        {yyval = automaton(); yyval.initials |= new_state; yyval.finals |= new_state;}
-#line 1397 "parser.cpp"
+  case 11: /* rationnal: IDENTIFIER EQUAL rationnal_rules SEMICOLON  */
+#line 165 "parser.yxx"
+                                                      {std::cout << *yyvsp[-1] << std::endl;add_automaton(*yyvsp[-1]);}
+#line 1252 "parser.cpp"
     break;
 
-  case 13:
-#line 80 "parser.yxx"
-                                                        {yyval = automaton(); yyval.initials |= {new_state}; yyval.finals |= {new_state+1}; yyval.transitions |= transition(new_state, terminal, new_state+1); new_state = new_state + 2; std::cout << "TERMINAL" << yyval <<  std::endl;}
-#line 1403 "parser.cpp"
+  case 12: /* rationnal_rules: %empty  */
+#line 174 "parser.yxx"
+                                                        {yyval = new_value(); yyval->initials |= new_state; yyval->finals |= new_state;}
+#line 1258 "parser.cpp"
     break;
 
-  case 14:
-#line 81 "parser.yxx"
-                                                        {yyval = yyvsp[-1]; yyval.transitions |= transition(new_state - 1, new_state); yyval.transitions |= transition(new_state, terminal, new_state + 1); yyval.finals -= yyvsp[-1].finals[0]; yyval.finals |= new_state + 1; new_state = new_state + 2; std::cout << "RR TERMINAL" << yyval <<  std::endl;}
-#line 1409 "parser.cpp"
+  case 13: /* rationnal_rules: TERMINAL  */
+#line 175 "parser.yxx"
+                                                        {yyval = new_value(); yyval->initials |= {new_state}; yyval->finals |= {new_state+1}; yyval->transitions |= transition(new_state, terminal, new_state+1); new_state = new_state + 2; std::cout << "TERMINAL" << *yyval <<  std::endl;}
+#line 1264 "parser.cpp"
     break;
 
-  case 15:
-#line 82 "parser.yxx"
-                                                        {yyval = yyvsp[-1]; yyval.transitions |= transition(yyvsp[-1].finals[0], new_state - 2);std::cout << "PLUS" << yyval <<  std::endl;}
-#line 1415 "parser.cpp"
+  case 14: /* rationnal_rules: rationnal_rules TERMINAL  */
+#line 176 "parser.yxx"
+                                                        {yyval->transitions |= transition(new_state - 1, new_state); yyval->transitions |= transition(new_state, terminal, new_state + 1); yyval->finals -= yyvsp[-1]->finals[0]; yyval->finals |= new_state + 1; new_state = new_state + 2; std::cout << "RR TERMINAL" << *yyval <<  std::endl;}
+#line 1270 "parser.cpp"
     break;
 
-  case 16:
-#line 83 "parser.yxx"
-                                                        {yyval = yyvsp[-1]; yyval.transitions |= transition(new_state - 2, yyvsp[-1].finals[0]); yyval.transitions |= transition(yyvsp[-1].finals[0], new_state - 2);std::cout << "STAR" << yyval <<  std::endl;}
-#line 1421 "parser.cpp"
+  case 15: /* rationnal_rules: rationnal_rules PLUS  */
+#line 177 "parser.yxx"
+                                                        {yyval->transitions |= transition(yyvsp[-1]->finals[0], new_state - 2);std::cout << "PLUS" << *yyval <<  std::endl;}
+#line 1276 "parser.cpp"
     break;
 
-  case 17:
-#line 84 "parser.yxx"
-                                                        {yyval = yyvsp[-3]; yyval.finals = yyvsp[-1].finals; yyval.transitions |= yyvsp[-1].transitions; yyval.transitions |= transition(yyvsp[-3].finals[0], yyvsp[-1].initials[0]); new_state = new_state + 1;std::cout << "PAR" << yyval <<  std::endl;}
-#line 1427 "parser.cpp"
+  case 16: /* rationnal_rules: rationnal_rules STAR  */
+#line 178 "parser.yxx"
+                                                        {yyval->transitions |= transition(new_state - 2, yyvsp[-1]->finals[0]); yyval->transitions |= transition(yyvsp[-1]->finals[0], new_state - 2);std::cout << "STAR" << *yyval <<  std::endl;}
+#line 1282 "parser.cpp"
     break;
 
-  case 18:
-#line 85 "parser.yxx"
-                                                        {yyval = automaton(); yyval.initials |= new_state + 1; yyval.finals |= new_state + 2; yyval.transitions |= transition(yyval.initials[0], yyvsp[-2].initials[0]);
-                                                        yyval.transitions |= transition(yyval.initials[0], yyvsp[0].initials[0]); yyval.transitions |= yyvsp[-2].transitions; yyval.transitions |= yyvsp[0].transitions;
-                                                        yyval.transitions |= transition(yyvsp[-2].finals[0], yyval.finals[0]); yyval.transitions |= transition(yyvsp[0].finals[0], yyval.finals[0]); new_state = new_state + 2;std::cout << "OR" << yyval <<  std::endl;}
-#line 1435 "parser.cpp"
+  case 17: /* rationnal_rules: rationnal_rules L_PAR rationnal_rules R_PAR  */
+#line 179 "parser.yxx"
+                                                        {yyval->transitions |= transition(yyvsp[-3]->finals[0], yyvsp[-1]->initials[0]); yyval->finals = std::move(yyvsp[-1]->finals); yyval->transitions |= std::move(yyvsp[-1]->transitions); new_state = new_state + 1;std::cout << "PAR" << *yyval <<  std::endl;}
+#line 1288 "parser.cpp"
     break;
 
-  case 19:
-#line 88 "parser.yxx"
-                                                        {yyval = yyvsp[-4]; yyval.finals = yyvsp[-2].finals; yyval.transitions |= yyvsp[-2].transitions; yyval.transitions |= transition(yyvsp[-4].finals[0], yyvsp[-2].initials[0]); yyval.transitions |= transition(yyval.finals[0], yyvsp[-2].initials[0]);std::cout << "PAR PLUS" << yyval <<  std::endl;}
-#line 1441 "parser.cpp"
+  case 18: /* rationnal_rules: rationnal_rules OR rationnal_rules  */
+#line 180 "parser.yxx"
+                                                        {yyval = new_value(); yyval->initials |= new_state + 1; yyval->finals |= new_state + 2; yyval->transitions |= transition(yyval->initials[0], yyvsp[-2]->initials[0]);
+                                                        yyval->transitions |= transition(yyval->initials[0], yyvsp[0]->initials[0]); yyval->transitions |= std::move(yyvsp[-2]->transitions); yyval->transitions |= std::move(yyvsp[0]->transitions);
+                                                        yyval->transitions |= transition(yyvsp[-2]->finals[0], yyval->finals[0]); yyval->transitions |= transition(yyvsp[0]->finals[0], yyval->finals[0]); new_state = new_state + 2;std::cout << "OR" << *yyval <<  std::endl;}
+#line 1296 "parser.cpp"
     break;
 
-  case 20:
-#line 89 "parser.yxx"
-                                                        {yyval = yyvsp[-4]; yyval.finals = yyvsp[-2].finals; yyval.transitions |= yyvsp[-2].transitions; yyval.transitions |= transition(yyvsp[-4].finals[0], yyvsp[-2].initials[0]); yyval.transitions |= transition(yyval.finals[0], yyvsp[-2].initials[0]); yyval.transitions |= transition(yyvsp[-2].initials[0], yyval.finals[0]);std::cout << "PAR STAR" << yyval <<  std::endl;}
-#line 1447 "parser.cpp"
+  case 19: /* rationnal_rules: rationnal_rules L_PAR rationnal_rules R_PAR PLUS  */
+#line 183 "parser.yxx"
+                                                        {yyval->transitions |= transition(yyvsp[-4]->finals[0], yyvsp[-2]->initials[0]); yyval->finals = std::move(yyvsp[-2]->finals); yyval->transitions |= std::move(yyvsp[-2]->transitions); yyval->transitions |= transition(yyval->finals[0], yyvsp[-2]->initials[0]);std::cout << "PAR PLUS" << *yyval <<  std::endl;}
+#line 1302 "parser.cpp"
+    break;
+
+  case 20: /* rationnal_rules: rationnal_rules L_PAR rationnal_rules R_PAR STAR  */
+#line 184 "parser.yxx"
+                                                        {yyval->transitions |= transition(yyvsp[-4]->finals[0], yyvsp[-2]->initials[0]); yyval->finals = std::move(yyvsp[-2]->finals); yyval->transitions |= std::move(yyvsp[-2]->transitions); yyval->transitions |= transition(yyval->finals[0], yyvsp[-2]->initials[0]); yyval->transitions |= transition(yyvsp[-2]->initials[0], yyval->finals[0]);std::cout << "PAR STAR" << *yyval <<  std::endl;}
+#line 1308 "parser.cpp"
     break;
 
 
-#line 1451 "parser.cpp"
+#line 1312 "parser.cpp"
 
       default: break;
     }
@@ -1462,11 +1323,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
@@ -1490,50 +1350,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -1566,6 +1390,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1582,13 +1407,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -1602,7 +1428,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1614,7 +1440,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1625,7 +1451,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -1633,24 +1459,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -1666,20 +1490,18 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 92 "parser.yxx"
+
+#line 187 "parser.yxx"
 
 
 void yyerror(const char *s) {
@@ -1693,12 +1515,18 @@ void yyerror(const char *s) {
  * This functions is documented in file lea.cpp
  */
 set<automaton> read_lea_file(char* file) {
-  automata = set<automaton>();   // initialize the set of automata
+  set<automaton> parsed;         // initialize the set of automata, outside of the arena
+  automata = &parsed;
+  arena_scope arena;             // the values of each automaton are allocated in the arena, released after each automaton
+  values_arena = &arena;
   yyin=fopen(file,"r");          // connect the file to the lexer
   if(yyin==NULL) {		 
     printf("\n Error ! \n");
   } else {
     yyparse(); 	                 // read the file
   }
-  return automata;
+  values.clear();                // the values of an automaton with a syntax error are released with the arena
+  values_arena = nullptr;
+  automata = nullptr;
+  return parsed;
 }
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -31,8 +31,9 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
 #ifndef YY_YY_PARSER_HPP_INCLUDED
 # define YY_YY_PARSER_HPP_INCLUDED
@@ -43,35 +44,46 @@
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 1 "parser.yxx"
 
-/* Token type.  */
+#include "automaton.hpp"
+
+#line 53 "parser.hpp"
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    AUTOMATE_KW = 258,
-    INITIAL_KW = 259,
-    FINAL_KW = 260,
-    SEMICOLON = 261,
-    EQUAL = 262,
-    OR = 263,
-    STAR = 264,
-    PLUS = 265,
-    L_PAR = 266,
-    R_PAR = 267,
-    L_BRACE = 268,
-    R_BRACE = 269,
-    L_TRANS = 270,
-    R_TRANS = 271,
-    IDENTIFIER = 272,
-    TERMINAL = 273,
-    NONTERMINAL = 274
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    AUTOMATE_KW = 258,             /* AUTOMATE_KW  */
+    INITIAL_KW = 259,              /* INITIAL_KW  */
+    FINAL_KW = 260,                /* FINAL_KW  */
+    SEMICOLON = 261,               /* SEMICOLON  */
+    EQUAL = 262,                   /* EQUAL  */
+    OR = 263,                      /* OR  */
+    STAR = 264,                    /* STAR  */
+    PLUS = 265,                    /* PLUS  */
+    L_PAR = 266,                   /* L_PAR  */
+    R_PAR = 267,                   /* R_PAR  */
+    L_BRACE = 268,                 /* L_BRACE  */
+    R_BRACE = 269,                 /* R_BRACE  */
+    L_TRANS = 270,                 /* L_TRANS  */
+    R_TRANS = 271,                 /* R_TRANS  */
+    IDENTIFIER = 272,              /* IDENTIFIER  */
+    TERMINAL = 273,                /* TERMINAL  */
+    NONTERMINAL = 274              /* NONTERMINAL  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef int YYSTYPE;
+typedef univ_nantes::automaton* YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
@@ -79,6 +91,8 @@ typedef int YYSTYPE;
 
 extern YYSTYPE yylval;
 
+
 int yyparse (void);
 
+
 #endif /* !YY_YY_PARSER_HPP_INCLUDED  */
@@ -10,10 +10,267 @@
  */
 
 #include <vector>
+#include <memory_resource>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <cstdint>
+#include "sorted_merge.hpp"
 
 namespace univ_nantes {
 
+  /**
+   * \class sorted_policy set.hpp
+   * \brief Storage policy keeping the elements of a set in a sorted vector
+   *
+   * Membership is tested by binary search, in O(log n). Unions, intersections, differences and inclusions
+   * are computed by merging the two sorted sequences, in O(n+m), with the kernels of sorted_merge.hpp.
+   * Elements are enumerated in increasing order.
+   * The elements must be totally ordered by Compare.
+   *
+   * By default, the elements are allocated from the std::pmr default memory resource that is current when the set is built.
+   */
+  template<typename T, typename Compare = std::less<T>, typename Container = std::pmr::vector<T>>
+  class sorted_policy {
+  private:
+    Container elements; /*!< Elements of the set, sorted by Compare and without duplicates. */
+  public:
+    typedef typename Container::const_iterator const_iterator;
+
+    std::size_t size() const { return elements.size(); }
+    const T & operator[] (std::size_t i) const { return elements[i]; }
+    const_iterator begin() const { return elements.begin(); }
+    const_iterator end() const { return elements.end(); }
+    void clear() { elements.clear(); }
+
+    bool contains(const T& x) const {
+      auto it = std::lower_bound(elements.begin(), elements.end(), x, Compare());
+      return it != elements.end() && !Compare()(x, *it);
+    }
+
+    /**
+     * \fn bool insert(const T& x)
+     * \brief Inserts x at its place in the sorted vector
+     * \return true if x was not already in the set
+     *
+     * Appending a greatest element, which is the common case when states are numbered incrementally, costs O(1).
+     */
+    template<typename U>
+    bool insert(U&& x) {
+      if(elements.empty() || Compare()(elements.back(), x)) {
+	elements.push_back(std::forward<U>(x));
+	return true;
+      }
+      auto it = std::lower_bound(elements.begin(), elements.end(), x, Compare());
+      if(!Compare()(x, *it)) return false;
+      elements.insert(it, std::forward<U>(x));
+      return true;
+    }
+
+    void reserve(std::size_t n) { elements.reserve(n); }
+
+    /**
+     * \fn void insert(InputIterator first, InputIterator last)
+     * \brief Inserts the elements of [first, last), in any order and possibly with duplicates
+     *
+     * The elements are appended, then sorted and deduplicated once, and finally merged with the former elements,
+     * in O((n+m) log m) instead of O(n*m) for m insertions one by one.
+     */
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      auto equivalent = [](const T& x, const T& y) { return !Compare()(x, y); };
+      std::size_t old_size = elements.size();
+      elements.insert(elements.end(), first, last);
+      auto middle = elements.begin() + old_size;
+      std::sort(middle, elements.end(), Compare());
+      elements.erase(std::unique(middle, elements.end(), equivalent), elements.end());
+      if(old_size == 0 || middle == elements.end() || Compare()(*(middle - 1), *middle)) return;
+      std::inplace_merge(elements.begin(), elements.begin() + old_size, elements.end(), Compare());
+      elements.erase(std::unique(elements.begin(), elements.end(), equivalent), elements.end());
+    }
+
+    /**
+     * \fn void assign_sorted_unique(InputIterator first, InputIterator last)
+     * \brief Replaces the elements by those of [first, last), which must be sorted by Compare and without duplicates
+     */
+    template<typename InputIterator>
+    void assign_sorted_unique(InputIterator first, InputIterator last) {
+      elements.clear();
+      elements.insert(elements.end(), first, last);
+    }
+
+    void erase(const T& x) {
+      auto it = std::lower_bound(elements.begin(), elements.end(), x, Compare());
+      if(it != elements.end() && !Compare()(x, *it))
+	elements.erase(it);
+    }
+
+    void unite(const sorted_policy& rhs) {
+      if(rhs.elements.empty()) return;
+      if(elements.empty() || Compare()(elements.back(), rhs.elements.front())) {
+	elements.insert(elements.end(), rhs.elements.begin(), rhs.elements.end());
+	return;
+      }
+      Container result;
+      sorted_merge<T, Compare>::unite(elements, rhs.elements, result);
+      elements = std::move(result);
+    }
+
+    void unite(sorted_policy&& rhs) {
+      if(elements.empty()) elements = std::move(rhs.elements);
+      else unite(rhs);
+    }
+
+    void intersect(const sorted_policy& rhs) { sorted_merge<T, Compare>::intersect(elements, rhs.elements); }
+    void subtract(const sorted_policy& rhs) { sorted_merge<T, Compare>::subtract(elements, rhs.elements); }
+
+    bool included_in(const sorted_policy& rhs) const {
+      return std::includes(rhs.elements.begin(), rhs.elements.end(), elements.begin(), elements.end(), Compare());
+    }
+
+    /**
+     * \fn bool equals(const sorted_policy& rhs) const
+     * \brief Two sets are equal if, and only if, their sorted vectors are equal, which is checked by a single pass
+     */
+    bool equals(const sorted_policy& rhs) const {
+      return elements.size() == rhs.elements.size()
+	&& std::equal(elements.begin(), elements.end(), rhs.elements.begin(),
+		      [](const T& x, const T& y) { return !Compare()(x, y) && !Compare()(y, x); });
+    }
+  };
+
+  /**
+   * \class hash_policy set.hpp
+   * \brief Storage policy indexing the elements of a set by an open-addressing hash table
+   *
+   * Elements are stored in insertion order in a vector, and the table maps them to their position, using linear probing.
+   * Membership is tested in O(1) expected time, and unions, intersections, differences and inclusions in O(n+m).
+   * The elements must be hashable by Hash.
+   *
+   * By default, the elements and the table are allocated from the std::pmr default memory resource that is current when the set is built.
+   */
+  template<typename T, typename Hash = std::hash<T>, typename Container = std::pmr::vector<T>>
+  class hash_policy {
+  private:
+    Container elements;              /*!< Elements of the set, in insertion order. */
+    std::pmr::vector<std::size_t> slots;  /*!< Hash table: 0 for an empty slot, i+1 for the element elements[i]. The size is a power of 2. */
+
+    std::size_t slot_of(const T& x) const {
+      std::uint64_t h = Hash()(x);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      std::size_t mask = slots.size() - 1;
+      std::size_t i = h & mask;
+      while(slots[i] != 0 && !(elements[slots[i]-1] == x))
+	i = (i + 1) & mask;
+      return i;
+    }
+
+    void reindex(std::size_t capacity) {
+      slots.assign(capacity, 0);
+      for(std::size_t i = 0; i < elements.size(); ++i)
+	slots[slot_of(elements[i])] = i + 1;
+    }
+
+    void reindex() {
+      std::size_t capacity = 8;
+      while(capacity < 2 * elements.size()) capacity *= 2;
+      reindex(capacity);
+    }
+
+  public:
+    typedef typename Container::const_iterator const_iterator;
+
+    std::size_t size() const { return elements.size(); }
+    const T & operator[] (std::size_t i) const { return elements[i]; }
+    const_iterator begin() const { return elements.begin(); }
+    const_iterator end() const { return elements.end(); }
+    void clear() { elements.clear(); slots.clear(); }
+
+    bool contains(const T& x) const {
+      return !elements.empty() && slots[slot_of(x)] != 0;
+    }
+
+    template<typename U>
+    bool insert(U&& x) {
+      if(2 * (elements.size() + 1) > slots.size())
+	reindex(slots.empty() ? 8 : 2 * slots.size());
+      std::size_t i = slot_of(x);
+      if(slots[i] != 0) return false;
+      elements.push_back(std::forward<U>(x));
+      slots[i] = elements.size();
+      return true;
+    }
+
+    void reserve(std::size_t n) {
+      elements.reserve(n);
+      std::size_t capacity = slots.empty() ? 8 : slots.size();
+      while(capacity < 2 * n) capacity *= 2;
+      if(capacity > slots.size()) reindex(capacity);
+    }
+
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      for(; first != last; ++first)
+	insert(*first);
+    }
+
+    template<typename InputIterator>
+    void assign_sorted_unique(InputIterator first, InputIterator last) {
+      clear();
+      insert(first, last);
+    }
+
+    void erase(const T& x) {
+      if(!contains(x)) return;
+      elements.erase(std::find(elements.begin(), elements.end(), x));
+      reindex();
+    }
+
+    void unite(const hash_policy& rhs) {
+      for(const T& x : rhs.elements)
+	insert(x);
+    }
+
+    void unite(hash_policy&& rhs) {
+      if(elements.empty()) *this = std::move(rhs);
+      else unite(rhs);
+    }
+
+    void intersect(const hash_policy& rhs) {
+      Container kept;
+      for(const T& x : elements)
+	if(rhs.contains(x)) kept.push_back(x);
+      elements = std::move(kept);
+      reindex();
+    }
+
+    void subtract(const hash_policy& rhs) {
+      Container kept;
+      for(const T& x : elements)
+	if(!rhs.contains(x)) kept.push_back(x);
+      elements = std::move(kept);
+      reindex();
+    }
+
+    bool included_in(const hash_policy& rhs) const {
+      if(elements.size() > rhs.elements.size()) return false;
+      for(const T& x : elements)
+	if(!rhs.contains(x)) return false;
+      return true;
+    }
+
+    /**
+     * \fn bool equals(const hash_policy& rhs) const
+     * \brief Two sets of the same size are equal if, and only if, one is included into the other
+     */
+    bool equals(const hash_policy& rhs) const {
+      return elements.size() == rhs.elements.size() && included_in(rhs);
+    }
+  };
+
   /**
    * \class set set.hpp 
    * \brief Encodes a type to manipulate sets algebrically 
@@ -24,11 +281,19 @@ namespace univ_nantes {
    *                For example, S1 | S2 == {1, 2, 3, 4, 5}, and S1 |= S2 is the same as S1 = {1, 2, 3, 4, 5};
    *   - set intersection: S1 & S2 represents the intersection of S1 and S2. 
    *                For example, S1 | S2 == {1, 2, 3, 4, 5}, and S1 |= S2 is the same as S1 = {1, 2, 3, 4, 5};
+   *
+   * The way elements are stored is chosen by the Policy parameter:
+   *   - sorted_policy<T> (default): sorted vector, requires operator< on T;
+   *   - hash_policy<T>: insertion-ordered vector indexed by a hash table, requires std::hash<T> and operator== on T.
+   *
+   * With both policies, a set takes its memory from the std::pmr default memory resource that is current when it is
+   * constructed (see arena_scope in arena.hpp). Copies are allocated from the resource current at the time of the copy,
+   * while moved sets keep the resource of their source.
    */
-  template<typename T>
+  template<typename T, typename Policy = sorted_policy<T>>
   class set {
   private:
-    std::vector<T> internal; /*!< The set is encoded internally as a vector. */
+    Policy internal; /*!< The set is encoded internally by its storage policy. */
   public:
 
     /**
@@ -45,7 +310,15 @@ namespace univ_nantes {
      *
      * Allows to write set<T> s = e;
      */
-    set(const set & e) : internal(e.internal) { }
+    set(const set & e) = default;
+    /**
+     * \fn set(set && e)
+     * \brief move constructor
+     * \param e a set whose storage is taken over, and left empty
+     *
+     * Allows to return sets by value, and to write set<T> s = std::move(e); without copying the elements.
+     */
+    set(set && e) noexcept : internal(std::move(e.internal)) { e.internal.clear(); }
     /**
      * \fn set(const std::initializer_list<T> & c)
      * \brief Initializer list constructor
@@ -53,12 +326,14 @@ namespace univ_nantes {
      *
      * Allows to write set<T> s = {1, 2, 3, 4};
      */
-    set(const std::initializer_list<T> & c) : internal(c) { }
+    set(const std::initializer_list<T> & c) {
+      internal.insert(c.begin(), c.end());
+    }
     /**
      * \fn ~set() 
      * \brief Default destructor
      */
-    ~set() {}
+    ~set() = default;
 
     /**
      * std::size_t size() const 
@@ -76,9 +351,7 @@ namespace univ_nantes {
      * \return true if x is in the set, false otherwise
      */
     bool contains(const T& x) const {
-      for(T y:internal)
-	if (x==y) return true;
-      return false;
+      return internal.contains(x);
     }
     
     /**
@@ -94,6 +367,114 @@ namespace univ_nantes {
 	internal = e.internal;
       return *this;
     }
+
+    /**
+     * \fn set& operator=(set&& e)
+     * \brief move assignation operator
+     * \param e a set whose storage is taken over, and left empty
+     * \return the same set
+     *
+     * Allows to write s = std::move(e); without copying the elements, unless both sets take their memory from
+     * different resources: the elements are then copied into the resource of this set, which can throw.
+     */
+    set& operator=(set&& e) {
+      if (this != &e) {
+	internal = std::move(e.internal);
+	e.internal.clear();
+      }
+      return *this;
+    }
+
+    /**
+     * \fn bool insert(U&& x)
+     * \brief Inserts x into the set, copying or moving it
+     * \param x an element to insert
+     * \return true if x was not already in the set, false otherwise
+     */
+    template<typename U>
+    bool insert(U&& x) {
+      return internal.insert(std::forward<U>(x));
+    }
+
+    /**
+     * \fn bool emplace(Args&&... args)
+     * \brief Constructs an element from args, and moves it into the set
+     * \param args the arguments of a constructor of T
+     * \return true if the element was not already in the set, false otherwise
+     *
+     * Allows to write transitions.emplace(1, 'a', 2);
+     */
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+      return internal.insert(T(std::forward<Args>(args)...));
+    }
+
+    /**
+     * \fn void insert(InputIterator first, InputIterator last)
+     * \brief Inserts all elements of the range [first, last) into the set
+     * \param first,last a range of elements, in any order and possibly with duplicates
+     *
+     * With the sorted policy, the range is sorted and deduplicated once, and then merged with the set.
+     */
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      internal.insert(first, last);
+    }
+
+    /**
+     * \fn void reserve(std::size_t n)
+     * \brief Makes room for n elements, so that the next insertions up to n elements do not reallocate
+     */
+    void reserve(std::size_t n) {
+      internal.reserve(n);
+    }
+
+    /**
+     * \fn static set from_sorted_unique(InputIterator first, InputIterator last)
+     * \brief Builds the set of the elements of [first, last), in O(n), without checking them
+     * \param first,last a range of elements, sorted in the order of the policy and without duplicates
+     * \return the set of the elements of the range
+     */
+    template<typename InputIterator>
+    static set from_sorted_unique(InputIterator first, InputIterator last) {
+      set result;
+      result.internal.assign_sorted_unique(first, last);
+      return result;
+    }
+
+    /**
+     * \class builder set.hpp
+     * \brief Collects elements with duplicates, and builds their set at once
+     *
+     * Allows to write
+     *   set<int>::builder b;
+     *   for(transition t : transitions) { b.add(t.start); b.add(t.end); }
+     *   set<int> states = b.build();
+     * in which the elements are sorted and deduplicated once by build(), instead of at each insertion.
+     */
+    class builder {
+    private:
+      std::pmr::vector<T> pending; /*!< Elements added so far, in order of addition, with duplicates. */
+    public:
+      void reserve(std::size_t n) { pending.reserve(n); }
+      void add(const T& x) { pending.push_back(x); }
+      void add(T&& x) { pending.push_back(std::move(x)); }
+      template<typename InputIterator>
+      void add(InputIterator first, InputIterator last) { pending.insert(pending.end(), first, last); }
+      std::size_t size() const { return pending.size(); }
+
+      /**
+       * \fn set build()
+       * \brief Gets the set of all elements added so far, and empties the builder
+       */
+      set build() {
+	set result;
+	result.reserve(pending.size());
+	result.insert(std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.end()));
+	pending.clear();
+	return result;
+      }
+    };
     
     /**
      * \fn friend std::ostream& operator<<(std::ostream& out, const set& e)
@@ -142,9 +523,7 @@ namespace univ_nantes {
      * Allows to write s1 |= s2, interpreted as "s1 = s1 union s2"
      */
     set& operator|=(const set& rhs) {
-      for(T y : rhs.internal)
-	if(!contains(y))
-	  internal.push_back(y);
+      internal.unite(rhs.internal);
       return *this;
     }
 
@@ -157,7 +536,27 @@ namespace univ_nantes {
      * 
      * Allows to write s1 | s2, interpreted as "s1 union s2".
      */
-    friend set operator|(set lhs, const set& rhs) { return lhs |= rhs; }
+    friend set operator|(set lhs, const set& rhs) { lhs |= rhs; return lhs; }
+
+    /**
+     * \fn friend set operator|(const set& lhs, set&& rhs)
+     * \brief Computes the union between lhs and rhs, reusing the storage of rhs
+     *
+     * Since the union is commutative, s1 | f() inserts s1 into the temporary result of f().
+     */
+    friend set operator|(const set& lhs, set&& rhs) { rhs |= lhs; return std::move(rhs); }
+
+    /**
+     * \fn set& operator|=(set&& rhs)
+     * \brief Inserts all elements of rhs into the set, taking over the storage of rhs if the set is empty
+     * \param rhs A set of elements to be inserted, left in an unspecified state
+     * \return The resulting set
+     */
+    set& operator|=(set&& rhs) {
+      internal.unite(std::move(rhs.internal));
+      rhs.internal.clear();
+      return *this;
+    }
 
     /**
      * \fn set& operator|=(const T& rhs)
@@ -168,8 +567,16 @@ namespace univ_nantes {
      * Allows to write s1 |= x, interpreted as "s1 = s1 union {x}".
      */
     set& operator|=(const T& rhs) {
-      if(!contains(rhs))
-	internal.push_back(rhs);
+      internal.insert(rhs);
+      return *this;
+    }
+
+    /**
+     * \fn set& operator|=(T&& rhs)
+     * \brief Moves rhs into the set
+     */
+    set& operator|=(T&& rhs) {
+      internal.insert(std::move(rhs));
       return *this;
     }
 
@@ -182,7 +589,7 @@ namespace univ_nantes {
      * 
      * Allows to write s1 | x, interpreted as "s1 union {x}".
      */
-    friend set operator|(set lhs, const T& rhs) { return lhs |= rhs; }
+    friend set operator|(set lhs, const T& rhs) { lhs |= rhs; return lhs; }
     
     /*********************************
      *      Set intersection         *
@@ -197,11 +604,7 @@ namespace univ_nantes {
      * Allows to write s1 &= s2, interpreted as "s1 = s1 intersection s2"
      */
     set& operator&=(const set& rhs) {
-      std::vector<T> new_internal;
-      for(T x : internal)
-	if(rhs.contains(x))
-	  new_internal.push_back(x);
-      internal = new_internal;
+      internal.intersect(rhs.internal);
       return *this;
     }
 
@@ -214,7 +617,15 @@ namespace univ_nantes {
      * 
      * Allows to write s1 & s2, interpreted as "s1 intersection s2".
      */
-    friend set operator&(set lhs, const set& rhs) { return lhs &= rhs; }
+    friend set operator&(set lhs, const set& rhs) { lhs &= rhs; return lhs; }
+
+    /**
+     * \fn friend set operator&(const set& lhs, set&& rhs)
+     * \brief Computes the intersection between lhs and rhs, reusing the storage of rhs
+     *
+     * Since the intersection is commutative, s1 & f() filters the temporary result of f() in place.
+     */
+    friend set operator&(const set& lhs, set&& rhs) { rhs &= lhs; return std::move(rhs); }
  
     /**
      * \fn set& operator&=(const T& rhs)
@@ -225,10 +636,10 @@ namespace univ_nantes {
      * Allows to write s1 &= x, interpreted as "s1 = s1 intersection {x}".
      */
     set& operator&=(const T& rhs) {
-      if(contains(rhs))
-	internal = std::vector<T>({rhs});
-      else
-	internal = std::vector<T>();
+      bool found = internal.contains(rhs);
+      internal.clear();
+      if(found)
+	internal.insert(rhs);
       return *this;
     }
     
@@ -240,7 +651,7 @@ namespace univ_nantes {
      * 
      * Allows to write s1 & x, interpreted as "s1 intersection {x}".
      */
-    friend set operator&(set lhs, const T& rhs) { return lhs &= rhs; }
+    friend set operator&(set lhs, const T& rhs) { lhs &= rhs; return lhs; }
 
     /*********************************
      *        Set difference         *
@@ -255,11 +666,7 @@ namespace univ_nantes {
      * Allows to write s1 -= s2, interpreted as "s1 = s1 minus s2"
      */
     set& operator-=(const set& rhs) {
-      std::vector<T> new_internal;
-      for(T x : internal)
-	if(!rhs.contains(x))
-	  new_internal.push_back(x);
-      internal = new_internal;
+      internal.subtract(rhs.internal);
       return *this;
     }
 
@@ -272,7 +679,7 @@ namespace univ_nantes {
      * 
      * Allows to write s1 - s2, interpreted as "s1 minus s2".
      */
-    friend set operator-(set lhs, const set& rhs) { return lhs -= rhs; }
+    friend set operator-(set lhs, const set& rhs) { lhs -= rhs; return lhs; }
  
     /**
      * \fn set& operator-=(const T& rhs)
@@ -283,11 +690,7 @@ namespace univ_nantes {
      * Allows to write s1 -= x, interpreted as "s1 = s1 minus {x}".
      */
     set& operator-=(const T& rhs) {
-      std::vector<T> new_internal;
-      for(T x : internal)
-	if(rhs != x)
-	  new_internal.push_back(x);
-      internal = new_internal;
+      internal.erase(rhs);
       return *this;
     }
 
@@ -300,7 +703,7 @@ namespace univ_nantes {
      * 
      * Allows to write s1 - x, interpreted as "s1 = s1 minus {x}".
      */
-    friend set operator-(set lhs, const T& rhs) { return lhs -= rhs; }
+    friend set operator-(set lhs, const T& rhs) { lhs -= rhs; return lhs; }
 
     
     /*********************************
@@ -317,10 +720,7 @@ namespace univ_nantes {
      * Allows to write s1 <= s2, interpreted as "s1 included into s2".
      */
     friend bool operator<= (const set& lhs, const set& rhs) {
-      for(T x : lhs.internal)
-	if(!rhs.contains(x))
-	  return false;
-      return true;
+      return lhs.internal.included_in(rhs.internal);
     }
 
     /**
@@ -331,8 +731,9 @@ namespace univ_nantes {
      * \return true if lhs and rhs contain the same elements; false otherwise
      * 
      * Allows to write s1 == s2, interpreted as "s1 equals s2".
+     * Sets of different sizes are told apart in constant time; otherwise, the comparison is linear.
      */
-    friend bool operator== (const set& lhs, const set& rhs){ return lhs <= rhs && rhs <= lhs; }
+    friend bool operator== (const set& lhs, const set& rhs){ return lhs.internal.equals(rhs.internal); }
 
     /**
      * \fn friend bool operator!= (const set& lhs, const set& rhs)
@@ -343,7 +744,7 @@ namespace univ_nantes {
      * 
      * Allows to write s1 != s2, interpreted as "s1 not equals to s2".
      */
-    friend bool operator!= (const set& lhs, const set& rhs){ return !(lhs <= rhs) || !(rhs <= lhs); }
+    friend bool operator!= (const set& lhs, const set& rhs){ return !lhs.internal.equals(rhs.internal); }
 
     /**
      * \fn friend bool operator>= (const set& lhs, const set& rhs)
@@ -364,6 +765,7 @@ namespace univ_nantes {
      * \return true if lhs is strictly included into rhs; false otherwise
      * 
      * Allows to write s1 < s2, interpreted as "s1 strictly included into s2".
+     * Note that this is not a total order: sorted sets of sets are ordered by std::less instead, which is lexicographic.
      */
     friend bool operator<  (const set& lhs, const set& rhs){ return lhs <= rhs && !(rhs <= lhs); }
 
@@ -394,8 +796,65 @@ namespace univ_nantes {
      * Necessary to write : for(T x : s), where s is of type set<T>
      */
     auto end() const {return internal.end();}
+
+    /**
+     * \fn std::size_t hash() const
+     * \brief Gets a hash of the set, that does not depend on the order in which the elements are stored
+     * \return the sum of the mixed hashes of the elements, so that equal sets have equal hashes
+     *
+     * Requires std::hash<T>.
+     */
+    std::size_t hash() const {
+      std::uint64_t h = internal.size();
+      for(const T& x : internal) {
+	std::uint64_t e = std::hash<T>()(x);
+	e ^= e >> 33;
+	e *= 0xff51afd7ed558ccdULL;
+	e ^= e >> 33;
+	h += e;
+      }
+      return (std::size_t)h;
+    }
+  };
+
+  /**
+   * \fn inline std::size_t hash_combine(std::size_t seed, std::size_t h)
+   * \brief Mixes the hash h into seed, to hash structures field by field
+   */
+  inline std::size_t hash_combine(std::size_t seed, std::size_t h) {
+    return seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+  }
+
+}
+
+namespace std {
+  /**
+   * \brief Allows to use univ_nantes::set as a key in unordered containers
+   */
+  template<typename T, typename Policy> struct hash<univ_nantes::set<T, Policy>> {
+    std::size_t operator()(const univ_nantes::set<T, Policy>& s) const { return s.hash(); }
+  };
+
+  /**
+   * \brief Orders sorted sets lexicographically, which is the total order used by sorted_policy for sets of sets
+   *
+   * The operator < of sets is the strict inclusion, which is not a strict weak order, so it cannot sort sets.
+   */
+  template<typename T, typename Compare, typename Container>
+  struct less<univ_nantes::set<T, univ_nantes::sorted_policy<T, Compare, Container>>> {
+    bool operator()(const univ_nantes::set<T, univ_nantes::sorted_policy<T, Compare, Container>>& lhs,
+		    const univ_nantes::set<T, univ_nantes::sorted_policy<T, Compare, Container>>& rhs) const {
+      return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), Compare());
+    }
   };
 
+  /**
+   * \brief Hashed sets have no order consistent with their equality: sets of them must be stored with a hash_policy
+   */
+  template<typename T, typename Hash, typename Container>
+  struct less<univ_nantes::set<T, univ_nantes::hash_policy<T, Hash, Container>>> {
+    static_assert(sizeof(T) == 0, "sets of hashed sets must be stored with a hash_policy");
+  };
 }
 
 #endif // SET_HPP_DEFINED
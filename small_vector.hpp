@@ -0,0 +1,185 @@
+#ifndef SMALL_VECTOR_HPP_DEFINED
+#define SMALL_VECTOR_HPP_DEFINED
+
+/**
+ * \file small_vector.hpp
+ * \brief Header file containing the declaration of the small_vector type, a vector with inline storage.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+namespace univ_nantes {
+
+  /**
+   * \class small_vector small_vector.hpp
+   * \brief Encodes a vector that stores up to N elements inside the object itself, and only allocates memory beyond
+   *
+   * Most sets of states built during the determinization are small: storing them inline avoids one allocation
+   * and one deallocation per temporary set. The interface is the subset of std::vector used by set and bitset.
+   * Elements are moved around with memcpy, so T must be trivially copyable.
+   */
+  template<typename T, std::size_t N>
+  class small_vector {
+    static_assert(std::is_trivially_copyable<T>::value, "small_vector only holds trivially copyable elements");
+    static_assert(N > 0, "small_vector needs some inline storage");
+
+  private:
+    T* elements;          /*!< Points to the inline buffer, or to the heap once the capacity exceeded N. */
+    std::size_t count;    /*!< Number of elements. */
+    std::size_t capacity_;/*!< Number of elements that fit in the current buffer. */
+    alignas(T) unsigned char buffer[N * sizeof(T)]; /*!< Inline storage for the first N elements. */
+
+    T* inline_elements() { return reinterpret_cast<T*>(buffer); }
+    bool is_inline() const { return elements == reinterpret_cast<const T*>(buffer); }
+
+    void release() {
+      if(!is_inline()) ::operator delete(elements);
+      elements = inline_elements();
+      capacity_ = N;
+    }
+
+    void copy_from(const small_vector& v) {
+      count = 0;
+      reserve(v.count);
+      if(v.count) std::memcpy(elements, v.elements, v.count * sizeof(T));
+      count = v.count;
+    }
+
+    void steal(small_vector& v) {
+      if(v.is_inline()) {
+	if(v.count) std::memcpy(elements, v.elements, v.count * sizeof(T));
+      } else {
+	elements = v.elements;
+	capacity_ = v.capacity_;
+	v.elements = v.inline_elements();
+	v.capacity_ = N;
+      }
+      count = v.count;
+      v.count = 0;
+    }
+
+  public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::size_t size_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+    small_vector() : elements(inline_elements()), count(0), capacity_(N) {}
+    small_vector(std::size_t n, const T& x) : small_vector() { resize(n, x); }
+    small_vector(std::initializer_list<T> l) : small_vector() { insert(end(), l.begin(), l.end()); }
+    small_vector(const small_vector& v) : small_vector() { copy_from(v); }
+    small_vector(small_vector&& v) noexcept : small_vector() { steal(v); }
+    ~small_vector() { release(); }
+
+    small_vector& operator=(const small_vector& v) {
+      if(this != &v) copy_from(v);
+      return *this;
+    }
+
+    small_vector& operator=(small_vector&& v) noexcept {
+      if(this != &v) {
+	release();
+	steal(v);
+      }
+      return *this;
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return count == 0; }
+    T* data() { return elements; }
+    const T* data() const { return elements; }
+    iterator begin() { return elements; }
+    iterator end() { return elements + count; }
+    const_iterator begin() const { return elements; }
+    const_iterator end() const { return elements + count; }
+    T& operator[](std::size_t i) { return elements[i]; }
+    const T& operator[](std::size_t i) const { return elements[i]; }
+    T& front() { return elements[0]; }
+    const T& front() const { return elements[0]; }
+    T& back() { return elements[count - 1]; }
+    const T& back() const { return elements[count - 1]; }
+
+    /**
+     * \fn void reserve(std::size_t n)
+     * \brief Makes room for n elements, moving the elements to the heap if n exceeds the current capacity
+     */
+    void reserve(std::size_t n) {
+      if(n <= capacity_) return;
+      std::size_t new_capacity = std::max(n, 2 * capacity_);
+      T* new_elements = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+      if(count) std::memcpy(new_elements, elements, count * sizeof(T));
+      if(!is_inline()) ::operator delete(elements);
+      elements = new_elements;
+      capacity_ = new_capacity;
+    }
+
+    void clear() { count = 0; }
+    void pop_back() { --count; }
+
+    void push_back(const T& x) {
+      T copy = x; // x may be an element of the vector
+      reserve(count + 1);
+      elements[count++] = copy;
+    }
+
+    void resize(std::size_t n, const T& x = T()) {
+      if(n > count) {
+	T copy = x;
+	reserve(n);
+	std::fill(elements + count, elements + n, copy);
+      }
+      count = n;
+    }
+
+    iterator insert(const_iterator position, const T& x) {
+      std::size_t i = position - elements;
+      T copy = x;
+      reserve(count + 1);
+      std::memmove(elements + i + 1, elements + i, (count - i) * sizeof(T));
+      elements[i] = copy;
+      ++count;
+      return elements + i;
+    }
+
+    template<typename ForwardIterator>
+    iterator insert(const_iterator position, ForwardIterator first, ForwardIterator last) {
+      std::size_t i = position - elements;
+      std::size_t n = std::distance(first, last);
+      reserve(count + n);
+      std::memmove(elements + i + n, elements + i, (count - i) * sizeof(T));
+      std::copy(first, last, elements + i);
+      count += n;
+      return elements + i;
+    }
+
+    iterator erase(const_iterator position) {
+      return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+      std::size_t i = first - elements;
+      std::size_t n = last - first;
+      std::memmove(elements + i, elements + i + n, (count - i - n) * sizeof(T));
+      count -= n;
+      return elements + i;
+    }
+
+    void swap(small_vector& v) {
+      small_vector tmp(std::move(v));
+      v = std::move(*this);
+      *this = std::move(tmp);
+    }
+  };
+
+}
+
+#endif // SMALL_VECTOR_HPP_DEFINED
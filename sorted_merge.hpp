@@ -0,0 +1,209 @@
+#ifndef SORTED_MERGE_HPP_DEFINED
+#define SORTED_MERGE_HPP_DEFINED
+
+/**
+ * \file sorted_merge.hpp
+ * \brief Header file containing the merge kernels used by sorted sets for unions, intersections and differences.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <smmintrin.h>
+#define SORTED_MERGE_SSE41 /*!< The SSE4.1 kernels are compiled, and chosen at run time if the processor supports them. */
+#endif
+
+namespace univ_nantes {
+
+  /**
+   * \struct sorted_merge sorted_merge.hpp
+   * \brief Computes the union, intersection and difference of two sorted sequences without duplicates, in linear time
+   *
+   * The containers must be sorted by Compare. The generic version relies on the standard merge algorithms;
+   * it is specialized for sets of integers, the sets of states of automata.
+   */
+  template<typename T, typename Compare>
+  struct sorted_merge {
+
+    /**
+     * \fn static void unite(const Container& a, const Container& b, Container& out)
+     * \brief Appends to the empty container out the sorted union of a and b
+     */
+    template<typename Container>
+    static void unite(const Container& a, const Container& b, Container& out) {
+      out.reserve(a.size() + b.size());
+      std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out), Compare());
+    }
+
+    /**
+     * \fn static void filter(Container& a, const Container& b, bool keep)
+     * \brief Keeps in a the elements that are in b if keep is true (intersection), or that are not in b otherwise (difference)
+     *
+     * The filtering is done in place, by a single merge of the two sorted sequences.
+     */
+    template<typename Container>
+    static void filter(Container& a, const Container& b, bool keep) {
+      auto out = a.begin();
+      auto r = b.begin();
+      for(auto it = a.begin(); it != a.end(); ++it) {
+	while(r != b.end() && Compare()(*r, *it)) ++r;
+	bool found = r != b.end() && !Compare()(*it, *r);
+	if(found == keep) {
+	  if(out != it) *out = std::move(*it);
+	  ++out;
+	}
+      }
+      a.erase(out, a.end());
+    }
+
+    template<typename Container>
+    static void intersect(Container& a, const Container& b) { filter(a, b, true); }
+
+    template<typename Container>
+    static void subtract(Container& a, const Container& b) { filter(a, b, false); }
+  };
+
+  /**
+   * \namespace univ_nantes::int_merge Merge kernels on sorted arrays of distinct integers
+   *
+   * The scalar loops work on raw arrays, and write the union into a buffer sized once. The scalar intersection
+   * is branchless: it writes its candidate output unconditionally, and advances the indices by the results of
+   * the comparisons. On x86 processors that support SSE4.1, the intersection compares blocks of 4 integers of each
+   * array at once: this kernel is compiled for SSE4.1 whatever the flags of the compiler, and is only called after
+   * sse41_supported() checked the processor at run time.
+   */
+  namespace int_merge {
+
+    /** writes the union of a[0..n-1] and b[0..m-1] into out, which has room for n+m integers, and returns its size */
+    inline std::size_t unite(const int* a, std::size_t n, const int* b, std::size_t m, int* out) {
+      std::size_t i = 0, j = 0, k = 0;
+      while(i < n && j < m) {
+	int x = a[i], y = b[j];
+	if(x < y) { out[k++] = x; ++i; }
+	else if(y < x) { out[k++] = y; ++j; }
+	else { out[k++] = x; ++i; ++j; }
+      }
+      while(i < n) out[k++] = a[i++];
+      while(j < m) out[k++] = b[j++];
+      return k;
+    }
+
+    /** removes from a[0..n-1], in place, the integers in b[0..m-1], and returns the new size of a */
+    inline std::size_t subtract(int* a, std::size_t n, const int* b, std::size_t m) {
+      std::size_t j = 0, k = 0;
+      for(std::size_t i = 0; i < n; ++i) {
+	int x = a[i];
+	while(j < m && b[j] < x) ++j;
+	if(j == m || b[j] != x) a[k++] = x;
+      }
+      return k;
+    }
+
+    /** writes the intersection of a[0..n-1] and b[0..m-1] into out, and returns its size; out may be a */
+    inline std::size_t intersect_scalar(const int* a, std::size_t n, const int* b, std::size_t m, int* out, std::size_t i = 0, std::size_t j = 0, std::size_t k = 0) {
+      while(i < n && j < m) {
+	int x = a[i], y = b[j];
+	out[k] = x;
+	k += x == y;
+	i += x <= y;
+	j += y <= x;
+      }
+      return k;
+    }
+
+#ifdef SORTED_MERGE_SSE41
+    /** true if the processor supports SSE4.1; the check is done once */
+    inline bool sse41_supported() {
+      static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("sse4.1"));
+      return supported;
+    }
+
+    /**
+     * \struct shuffle_table
+     * \brief For each 4-bit mask, the byte shuffle that packs the 32-bit lanes selected by the mask at the beginning of a vector
+     */
+    struct shuffle_table {
+      std::uint8_t bytes[16][16];
+      shuffle_table() {
+	for(int mask = 0; mask < 16; ++mask) {
+	  int k = 0;
+	  for(int lane = 0; lane < 4; ++lane)
+	    if(mask & (1 << lane)) {
+	      for(int byte = 0; byte < 4; ++byte) bytes[mask][4*k + byte] = 4*lane + byte;
+	      ++k;
+	    }
+	  for(int byte = 4*k; byte < 16; ++byte) bytes[mask][byte] = 0x80;
+	}
+      }
+    };
+
+    /**
+     * writes the intersection of a[0..n-1] and b[0..m-1] into out, and returns its size;
+     * out must have room for min(n, m) + 3 integers, and must not overlap a or b
+     */
+    __attribute__((target("sse4.1")))
+    inline std::size_t intersect(const int* a, std::size_t n, const int* b, std::size_t m, int* out) {
+      static const shuffle_table table;
+      std::size_t i = 0, j = 0, k = 0;
+      while(i + 4 <= n && j + 4 <= m) {
+	__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+	__m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+	// Compare each integer of va with the 4 rotations of vb
+	__m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(va, vb),
+					       _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+				  _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+					       _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+	int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+	__m128i packed = _mm_shuffle_epi8(va, _mm_loadu_si128((const __m128i*)table.bytes[mask]));
+	_mm_storeu_si128((__m128i*)(out + k), packed);
+	k += __builtin_popcount(mask);
+	int amax = a[i + 3], bmax = b[j + 3];
+	i += amax <= bmax ? 4 : 0;
+	j += bmax <= amax ? 4 : 0;
+      }
+      return intersect_scalar(a, n, b, m, out, i, j, k);
+    }
+#endif
+  }
+
+  /**
+   * \struct sorted_merge<int, std::less<int>>
+   * \brief Merge kernels for the sets of integers, by loops on raw arrays and, if the processor supports them, SSE4.1 instructions
+   */
+  template<>
+  struct sorted_merge<int, std::less<int>> {
+
+    static const std::size_t simd_threshold = 32; /*!< Smallest size of both operands for which the SSE4.1 intersection pays for its buffer. */
+
+    template<typename Container>
+    static void unite(const Container& a, const Container& b, Container& out) {
+      out.resize(a.size() + b.size());
+      out.resize(int_merge::unite(a.data(), a.size(), b.data(), b.size(), out.data()));
+    }
+
+    template<typename Container>
+    static void intersect(Container& a, const Container& b) {
+#ifdef SORTED_MERGE_SSE41
+      if(a.size() >= simd_threshold && b.size() >= simd_threshold && int_merge::sse41_supported()) {
+	Container buffer(std::min(a.size(), b.size()) + 3, 0);
+	std::size_t k = int_merge::intersect(a.data(), a.size(), b.data(), b.size(), buffer.data());
+	std::copy(buffer.data(), buffer.data() + k, a.data());
+	a.resize(k);
+	return;
+      }
+#endif
+      a.resize(int_merge::intersect_scalar(a.data(), a.size(), b.data(), b.size(), a.data()));
+    }
+
+    template<typename Container>
+    static void subtract(Container& a, const Container& b) {
+      a.resize(int_merge::subtract(a.data(), a.size(), b.data(), b.size()));
+    }
+  };
+
+}
+
+#endif // SORTED_MERGE_HPP_DEFINED
@@ -0,0 +1,98 @@
+/**
+ * \file subset_pool.cpp
+ * \brief Implementation file containing the code of the subset_pool type
+ */
+
+#include "subset_pool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace univ_nantes;
+
+const std::uint32_t subset_pool::sparse;
+
+subset_pool::subset_pool(std::size_t capacity) : max_words((capacity + 63) / 64), offsets(1, 0), slots(16, 0) { }
+
+std::uint32_t subset_pool::encode(const bitset& subset, code& encoding) {
+  std::size_t n = subset.word_count();
+  std::size_t first = 0;
+  while(first < n && subset.data()[first] == 0) ++first;
+  encoding.clear();
+  if(subset.size() * sizeof(std::uint32_t) < (n - first) * sizeof(words::word)) {
+    for(int x : subset) encoding.push_back((std::uint32_t)x);
+    return sparse;
+  }
+  encoding.resize(2 * (n - first));
+  std::memcpy(encoding.data(), subset.data() + first, (n - first) * sizeof(words::word));
+  return (std::uint32_t)first;
+}
+
+std::size_t subset_pool::find_slot(const code& encoding, std::uint32_t first, std::size_t h) const {
+  std::size_t mask = slots.size() - 1;
+  std::size_t i = h & mask;
+  while(slots[i] != 0) {
+    std::uint32_t id = slots[i] - 1;
+    if(hashes[id] == h && firsts[id] == first && offsets[id + 1] - offsets[id] == encoding.size()
+       && std::equal(encoding.data(), encoding.data() + encoding.size(), arena.data() + offsets[id]))
+      return i;
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+void subset_pool::grow() {
+  std::vector<std::uint32_t> larger(2 * slots.size(), 0);
+  slots.swap(larger);
+  std::size_t mask = slots.size() - 1;
+  for(std::uint32_t id = 0; id < hashes.size(); ++id) {
+    std::size_t i = hashes[id] & mask;
+    while(slots[i] != 0) i = (i + 1) & mask;
+    slots[i] = id + 1;
+  }
+}
+
+bool subset_pool::contains(const bitset& subset) const {
+  assert(subset.word_count() <= max_words); // subset must be a subset of {0, ..., capacity-1}
+  code encoding;
+  std::uint32_t first = encode(subset, encoding);
+  return slots[find_slot(encoding, first, subset.hash())] != 0;
+}
+
+std::pair<std::uint32_t, bool> subset_pool::intern(const bitset& subset) {
+  assert(subset.word_count() <= max_words); // subset must be a subset of {0, ..., capacity-1}
+  if(2 * (hashes.size() + 1) > slots.size()) grow();
+  code encoding;
+  std::uint32_t first = encode(subset, encoding);
+  std::size_t i = find_slot(encoding, first, subset.hash());
+  if(slots[i] != 0) return std::make_pair(slots[i] - 1, false);
+
+  std::uint32_t id = hashes.size();
+  arena.insert(arena.end(), encoding.data(), encoding.data() + encoding.size());
+  offsets.push_back(arena.size());
+  firsts.push_back(first);
+  hashes.push_back(subset.hash());
+  slots[i] = id + 1;
+  return std::make_pair(id, true);
+}
+
+bitset subset_pool::operator[](std::uint32_t id) const {
+  const std::uint32_t* encoding = arena.data() + offsets[id];
+  std::size_t n = offsets[id + 1] - offsets[id];
+  bitset result;
+  if(firsts[id] == sparse) {
+    // The greatest state first, so that the words are allocated once
+    for(std::size_t i = n; i > 0; --i)
+      result |= (int)encoding[i - 1];
+    return result;
+  }
+  small_vector<words::word, bitset::inline_words> window(n / 2, 0);
+  if(n > 0) // The empty set has no words, and the arena may not be allocated yet
+    std::memcpy(window.data(), encoding, n * sizeof(std::uint32_t));
+  return bitset(firsts[id], window.data(), window.size());
+}
+
+std::size_t subset_pool::bytes() const {
+  return arena.size() * sizeof(std::uint32_t) + offsets.size() * sizeof(std::size_t) + firsts.size() * sizeof(std::uint32_t)
+    + hashes.size() * sizeof(std::size_t) + slots.size() * sizeof(std::uint32_t);
+}
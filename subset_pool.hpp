@@ -0,0 +1,106 @@
+#ifndef SUBSET_POOL_HPP_DEFINED
+#define SUBSET_POOL_HPP_DEFINED
+
+/**
+ * \file subset_pool.hpp
+ * \brief Header file containing the declaration of the subset_pool type, used by the determinization.
+ */
+
+#include "bitset.hpp"
+#include "small_vector.hpp"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace univ_nantes {
+
+  /**
+   * \class subset_pool subset_pool.hpp
+   * \brief Stores each distinct set of states exactly once, and identifies it by a stable 32-bit id
+   *
+   * The subsets are stored one after the other in a single array, each one with the smaller of two encodings: its
+   * words from its first to its last non-null word, with the position of its first word, or the sorted list of its
+   * states, on 32 bits each. The sets of states of a determinization usually hold a few states, so they take a few
+   * bytes whatever the number of states of the automaton. A hash table with open addressing maps each subset to its id.
+   *
+   * Ids are given in order of insertion, starting from 0, and never change: two interned subsets are equal
+   * if, and only if, their ids are equal. The ids can directly be used as the states of the deterministic automaton.
+   */
+  class subset_pool {
+  private:
+    static const std::uint32_t sparse = 0xFFFFFFFF; /*!< Value of firsts[i] when subset i is stored as the list of its states. */
+    typedef small_vector<std::uint32_t, 16> code;   /*!< Encoding of a subset, as stored in the arena. */
+
+    std::size_t max_words;             /*!< Number of words of a subset of {0, ..., capacity-1}. */
+    std::vector<std::uint32_t> arena;  /*!< Encodings of all subsets: the one of subset i is arena[offsets[i] .. offsets[i+1]-1]. */
+    std::vector<std::size_t> offsets;  /*!< offsets[i] is the position in arena of subset i; offsets has size()+1 elements. */
+    std::vector<std::uint32_t> firsts; /*!< firsts[i] is sparse, or the index of the first word stored of subset i, whose previous words are null. */
+    std::vector<std::size_t> hashes;   /*!< hashes[i] is the hash of subset i. */
+    std::vector<std::uint32_t> slots;  /*!< Hash table: 0 for an empty slot, i+1 for subset i. The size is a power of 2. */
+
+    /**
+     * \fn static std::uint32_t encode(const bitset& subset, code& encoding)
+     * \brief Computes the encoding of subset, and returns its first word stored, or sparse
+     *
+     * The words take 2 elements of the encoding each. The encoding only depends on the subset, so that two subsets
+     * are equal if, and only if, their encodings are equal.
+     */
+    static std::uint32_t encode(const bitset& subset, code& encoding);
+
+    /**
+     * \fn std::size_t find_slot(const code& encoding, std::uint32_t first, std::size_t h) const
+     * \brief Gets the slot containing the subset of the given encoding and hash, or the empty slot where it should be inserted
+     */
+    std::size_t find_slot(const code& encoding, std::uint32_t first, std::size_t h) const;
+
+    /**
+     * \fn void grow()
+     * \brief Doubles the size of the hash table, and re-inserts all subsets
+     */
+    void grow();
+
+  public:
+
+    /**
+     * \fn subset_pool(std::size_t capacity)
+     * \brief Creates an empty pool, for subsets of {0, ..., capacity-1}
+     */
+    explicit subset_pool(std::size_t capacity);
+
+    /**
+     * \fn std::size_t size() const
+     * \brief Gets the number of distinct subsets in the pool
+     */
+    std::size_t size() const { return hashes.size(); }
+
+    /**
+     * \fn std::pair<std::uint32_t, bool> intern(const bitset& subset)
+     * \brief Gets the id of subset, adding subset to the pool if it was not there yet
+     * \param subset a subset of {0, ..., capacity-1}
+     * \return the id of subset, and true if, and only if, subset was added by this call
+     */
+    std::pair<std::uint32_t, bool> intern(const bitset& subset);
+
+    /**
+     * \fn bool contains(const bitset& subset) const
+     * \brief Gets whether subset, a subset of {0, ..., capacity-1}, is already in the pool
+     */
+    bool contains(const bitset& subset) const;
+
+    /**
+     * \fn std::size_t bytes() const
+     * \brief Gets the memory taken by the subsets of the pool and by its hash table, in bytes
+     */
+    std::size_t bytes() const;
+
+    /**
+     * \fn bitset operator[](std::uint32_t id) const
+     * \brief Gets a copy of the subset of the given id
+     */
+    bitset operator[](std::uint32_t id) const;
+  };
+
+}
+
+#endif // SUBSET_POOL_HPP_DEFINED
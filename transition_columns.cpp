@@ -0,0 +1,51 @@
+/**
+ * \file transition_columns.cpp
+ * \brief Implementation file containing the code of the transition_columns type
+ */
+
+#include "transition_columns.hpp"
+#include <climits>
+#include <algorithm>
+#include <vector>
+
+using namespace univ_nantes;
+
+transition_columns::transition_columns(const set<transition>& transitions) {
+  reserve(transitions.size());
+  for(const transition& t : transitions)
+    push_back(t);
+}
+
+set<char> transition_columns::alphabet() const {
+  bool used[UCHAR_MAX + 1] = {};
+  const char* labels = terminals.data();
+  for(std::size_t k = 0; k < terminals.size(); ++k)
+    used[(unsigned char)labels[k]] = true;
+  used[(unsigned char)'\0'] = false; // Epsilon transitions are not labelled by a symbol
+  char symbols[UCHAR_MAX + 1];
+  std::size_t n = 0;
+  for(int c = CHAR_MIN; c <= CHAR_MAX; ++c)
+    if(used[(unsigned char)c])
+      symbols[n++] = (char)c;
+  return set<char>::from_sorted_unique(symbols, symbols + n);
+}
+
+set<int> transition_columns::states() const {
+  // Like alphabet(): the states lie between the least and the greatest one, mark them, then list the marked ones
+  if(starts.empty()) return set<int>();
+  int least = starts.front(), greatest = starts.back(); // The start states are sorted
+  for(std::size_t k = 0; k < ends.size(); ++k) {
+    least = std::min(least, ends[k]);
+    greatest = std::max(greatest, ends[k]);
+  }
+  std::vector<char> used((std::size_t)(greatest - least) + 1, 0);
+  for(std::size_t k = 0; k < starts.size(); ++k) {
+    used[starts[k] - least] = 1;
+    used[ends[k] - least] = 1;
+  }
+  std::vector<int> states;
+  for(std::size_t i = 0; i < used.size(); ++i)
+    if(used[i])
+      states.push_back(least + (int)i);
+  return set<int>::from_sorted_unique(states.begin(), states.end());
+}
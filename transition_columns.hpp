@@ -0,0 +1,86 @@
+#ifndef TRANSITION_COLUMNS_HPP_DEFINED
+#define TRANSITION_COLUMNS_HPP_DEFINED
+
+/**
+ * \file transition_columns.hpp
+ * \brief Header file containing the declaration of the transition_columns type, a column-wise storage of transitions.
+ */
+
+#include "automaton.hpp"
+#include "set.hpp"
+#include <memory_resource>
+#include <cstddef>
+
+namespace univ_nantes {
+
+  /**
+   * \class transition_columns transition_columns.hpp
+   * \brief Stores transitions as three separate arrays of start states, terminals and end states, sorted by (start, terminal, end)
+   *
+   * A set<transition> is an array of structures: a scan that only reads the terminals also loads the states
+   * around them, 12 bytes per transition. Here each field is a contiguous array, so the scans of alphabet()
+   * and states() read only the columns they need, with simple loops that the compiler can vectorize.
+   *
+   * The transitions are kept in the order of set<transition>, so the transitions leaving a state are contiguous,
+   * sorted by terminal.
+   */
+  class transition_columns {
+  private:
+    std::pmr::vector<int> starts;     /*!< starts[k] is the start state of the k-th transition. */
+    std::pmr::vector<char> terminals; /*!< terminals[k] is the label of the k-th transition. */
+    std::pmr::vector<int> ends;       /*!< ends[k] is the end state of the k-th transition. */
+
+  public:
+
+    /**
+     * \fn transition_columns()
+     * \brief Creates an empty store
+     */
+    transition_columns() {}
+
+    /**
+     * \fn explicit transition_columns(const set<transition>& transitions)
+     * \brief Copies the transitions in columns, in one pass
+     */
+    explicit transition_columns(const set<transition>& transitions);
+
+    /**
+     * \fn void reserve(std::size_t n)
+     * \brief Makes room for n transitions
+     */
+    void reserve(std::size_t n) { starts.reserve(n); terminals.reserve(n); ends.reserve(n); }
+
+    /**
+     * \fn void push_back(const transition& t)
+     * \brief Appends t, which must not come before the last transition in the order of set<transition>
+     */
+    void push_back(const transition& t) { starts.push_back(t.start); terminals.push_back(t.terminal); ends.push_back(t.end); }
+
+    std::size_t size() const { return starts.size(); }
+    int start(std::size_t k) const { return starts[k]; }
+    char terminal(std::size_t k) const { return terminals[k]; }
+    int end(std::size_t k) const { return ends[k]; }
+    transition operator[](std::size_t k) const { return transition(starts[k], terminals[k], ends[k]); }
+
+    /**
+     * \fn const char* terminal_data() const
+     * \brief Gives a read-only access to the column of terminals, for instance to search it
+     */
+    const char* terminal_data() const { return terminals.data(); }
+
+    /**
+     * \fn set<char> alphabet() const
+     * \brief Same as automaton::get_alphabet(), reading only the terminals
+     */
+    set<char> alphabet() const;
+
+    /**
+     * \fn set<int> states() const
+     * \brief Gets the states at the start or the end of some transition, reading only the two columns of states
+     */
+    set<int> states() const;
+  };
+
+}
+
+#endif // TRANSITION_COLUMNS_HPP_DEFINED
@@ -0,0 +1,135 @@
+/**
+ * \file transition_index.cpp
+ * \brief Implementation file containing the code of the transition_index type
+ */
+
+#include "transition_index.hpp"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+using namespace univ_nantes;
+
+transition_index::transition_index(const set<transition>& transitions, std::size_t n) {
+  offsets.assign(n + 1, 0);
+  epsilon_offsets.assign(n + 1, 0);
+  columns_.reserve(transitions.size());
+  // Transitions are sorted by start state, so they are copied in order
+  for(const transition& t : transitions) {
+    assert(t.start >= 0 && (std::size_t)t.start < n && t.end >= 0 && (std::size_t)t.end < n); // The states must be numbered densely
+    ++offsets[t.start + 1];
+    columns_.push_back(t);
+    if(t.is_epsilon()) {
+      ++epsilon_offsets[t.start + 1];
+      epsilon_ends.push_back(t.end);
+    }
+  }
+  for(std::size_t q = 0; q < n; ++q) {
+    offsets[q + 1] += offsets[q];
+    epsilon_offsets[q + 1] += epsilon_offsets[q];
+  }
+}
+
+std::pair<std::uint32_t, std::uint32_t> transition_index::edges(int q, char c) const {
+  std::pair<std::uint32_t, std::uint32_t> all = edges(q);
+  const char* terminals = columns_.terminal_data();
+  auto range = std::equal_range(terminals + all.first, terminals + all.second, c);
+  return std::make_pair(range.first - terminals, range.second - terminals);
+}
+
+bitset transition_index::accessible(const bitset& from, char c) const {
+  bitset result;
+  for(int q : from) {
+    std::pair<std::uint32_t, std::uint32_t> range = edges(q, c);
+    for(std::uint32_t k = range.first; k < range.second; ++k)
+      result |= columns_.end(k);
+  }
+  return result;
+}
+
+bitset transition_index::epsilon_accessible(bitset from) const {
+  bitset result = std::move(from);
+  std::vector<int> pending(result.begin(), result.end());
+  while(!pending.empty()) {
+    int q = pending.back();
+    pending.pop_back();
+    if(q < 0 || (std::size_t)q >= state_count()) continue;
+    for(std::uint32_t k = epsilon_offsets[q]; k < epsilon_offsets[q + 1]; ++k) {
+      int r = epsilon_ends[k];
+      if(!result.contains(r)) {
+	result |= r;
+	pending.push_back(r);
+      }
+    }
+  }
+  return result;
+}
+
+bitset transition_index::reachable(bitset from) const {
+  bitset result = std::move(from);
+  std::vector<int> pending(result.begin(), result.end());
+  while(!pending.empty()) {
+    int q = pending.back();
+    pending.pop_back();
+    std::pair<std::uint32_t, std::uint32_t> range = edges(q);
+    for(std::uint32_t k = range.first; k < range.second; ++k) {
+      int r = columns_.end(k);
+      if(!result.contains(r)) {
+	result |= r;
+	pending.push_back(r);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<int> transition_index::epsilon_components(std::vector<int>* finished) const {
+  std::size_t n = state_count();
+  std::vector<int> component(n, -1);
+  std::vector<int> order(n, -1);  // Visit order of each state, or -1 if it was not visited yet
+  std::vector<int> low(n, 0);     // Smallest visit order reachable from the subtree of each state, through the stack
+  std::vector<bool> on_stack(n, false);
+  std::vector<int> stack;         // Visited states whose component is not known yet
+  std::vector<std::pair<int, std::uint32_t>> calls; // Explicit recursion: a state, and its next epsilon transition to follow
+  int visited = 0;
+
+  for(std::size_t s = 0; s < n; ++s) {
+    if(order[s] != -1) continue;
+    order[s] = low[s] = visited++;
+    stack.push_back(s);
+    on_stack[s] = true;
+    calls.push_back(std::make_pair((int)s, epsilon_offsets[s]));
+    while(!calls.empty()) {
+      int q = calls.back().first;
+      std::uint32_t k = calls.back().second;
+      if(k < epsilon_offsets[q + 1]) {
+	++calls.back().second;
+	int r = epsilon_ends[k];
+	if(order[r] == -1) {
+	  order[r] = low[r] = visited++;
+	  stack.push_back(r);
+	  on_stack[r] = true;
+	  calls.push_back(std::make_pair(r, epsilon_offsets[r]));
+	} else if(on_stack[r]) {
+	  low[q] = std::min(low[q], order[r]);
+	}
+	continue;
+      }
+      calls.pop_back();
+      if(!calls.empty())
+	low[calls.back().first] = std::min(low[calls.back().first], low[q]);
+      if(low[q] == order[q]) {
+	// q is the root of a component: its states are on the stack, above q
+	std::size_t first = std::find(stack.rbegin(), stack.rend(), q).base() - 1 - stack.begin();
+	int smallest = *std::min_element(stack.begin() + first, stack.end());
+	if(finished) finished->insert(finished->end(), stack.begin() + first, stack.end());
+	for(std::size_t i = first; i < stack.size(); ++i) {
+	  component[stack[i]] = smallest;
+	  on_stack[stack[i]] = false;
+	}
+	stack.resize(first);
+      }
+    }
+  }
+  return component;
+}
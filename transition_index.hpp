@@ -0,0 +1,143 @@
+#ifndef TRANSITION_INDEX_HPP_DEFINED
+#define TRANSITION_INDEX_HPP_DEFINED
+
+/**
+ * \file transition_index.hpp
+ * \brief Header file containing the declaration of the transition_index type, an adjacency index of the transitions of an automaton.
+ */
+
+#include "automaton.hpp"
+#include "bitset.hpp"
+#include "transition_columns.hpp"
+#include <memory_resource>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace univ_nantes {
+
+  /**
+   * \class transition_index transition_index.hpp
+   * \brief Immutable compressed sparse row index of a set of transitions, keyed by start state and terminal
+   *
+   * The transitions are stored in columns (see transition_columns.hpp), in the order of the set of transitions,
+   * which is copied in a single pass. The transitions leaving state q are at positions offsets[q] to offsets[q+1]-1,
+   * sorted by terminal, then by end state.
+   *
+   * The transitions labelled by c leaving q are found by a binary search among the transitions leaving q,
+   * so accessible() and epsilon_accessible() only touch the outgoing transitions of the states involved,
+   * instead of all the transitions of the automaton.
+   *
+   * The epsilon transitions are also indexed on their own, by the arrays epsilon_offsets and epsilon_ends, so that
+   * closures and the strongly connected components of the epsilon transitions follow them without any search.
+   *
+   * The index is a snapshot: it must be rebuilt if the transitions are modified. Its arrays have a row per state, so
+   * the states must be numbered densely from 0, as after automaton::compact(): the numbers written in a .lea file
+   * can be as large as INT_MAX, and must not size any array.
+   */
+  class transition_index {
+  private:
+    std::pmr::vector<std::uint32_t> offsets; /*!< Transitions leaving q are at positions offsets[q] .. offsets[q+1]-1; size state_count()+1. */
+    transition_columns columns_;             /*!< The indexed transitions, in the order of the set of transitions. */
+    std::pmr::vector<std::uint32_t> epsilon_offsets; /*!< Epsilon transitions leaving q lead to epsilon_ends[epsilon_offsets[q] .. epsilon_offsets[q+1]-1]. */
+    std::pmr::vector<int> epsilon_ends;              /*!< End states of the epsilon transitions, grouped by start state. */
+
+  public:
+
+    /**
+     * \fn transition_index(const set<transition>& transitions, std::size_t state_count)
+     * \brief Builds the index of the given transitions, in O(|transitions| + state_count)
+     * \param transitions the transitions to index, whose states must all be in {0, ..., state_count-1}
+     * \param state_count the number of states
+     */
+    transition_index(const set<transition>& transitions, std::size_t state_count);
+
+    /**
+     * \fn std::size_t state_count() const
+     * \brief Gets the number of indexed states, given at construction
+     */
+    std::size_t state_count() const { return offsets.size() - 1; }
+
+    /**
+     * \fn std::pair<std::uint32_t, std::uint32_t> edges(int q) const
+     * \brief Gets the positions [first, last) of the transitions leaving q
+     */
+    std::pair<std::uint32_t, std::uint32_t> edges(int q) const {
+      if(q < 0 || (std::size_t)q >= state_count()) return std::make_pair(0u, 0u);
+      return std::make_pair(offsets[q], offsets[q + 1]);
+    }
+
+    /**
+     * \fn std::pair<std::uint32_t, std::uint32_t> edges(int q, char c) const
+     * \brief Gets the positions [first, last) of the transitions leaving q labelled by c
+     */
+    std::pair<std::uint32_t, std::uint32_t> edges(int q, char c) const;
+
+    /**
+     * \fn std::pair<std::uint32_t, std::uint32_t> epsilon_edges(int q) const
+     * \brief Gets the positions [first, last) of the epsilon transitions leaving q, to be read with epsilon_end()
+     */
+    std::pair<std::uint32_t, std::uint32_t> epsilon_edges(int q) const {
+      if(q < 0 || (std::size_t)q >= state_count()) return std::make_pair(0u, 0u);
+      return std::make_pair(epsilon_offsets[q], epsilon_offsets[q + 1]);
+    }
+
+    /**
+     * \fn int epsilon_end(std::uint32_t k) const
+     * \brief Gets the end state of the epsilon transition at position k
+     */
+    int epsilon_end(std::uint32_t k) const { return epsilon_ends[k]; }
+
+    /**
+     * \fn char terminal(std::uint32_t k) const
+     * \brief Gets the label of the transition at position k
+     */
+    char terminal(std::uint32_t k) const { return columns_.terminal(k); }
+
+    /**
+     * \fn int end(std::uint32_t k) const
+     * \brief Gets the end state of the transition at position k
+     */
+    int end(std::uint32_t k) const { return columns_.end(k); }
+
+    /**
+     * \fn const transition_columns& columns() const
+     * \brief Gives a read-only access to the indexed transitions, for scans over all of them
+     */
+    const transition_columns& columns() const { return columns_; }
+
+    /**
+     * \fn bitset accessible(const bitset& from, char c) const
+     * \brief Same as automaton::accessible, in O(sum of the out-degrees of the states in from)
+     */
+    bitset accessible(const bitset& from, char c) const;
+
+    /**
+     * \fn bitset epsilon_accessible(bitset from) const
+     * \brief Same as automaton::epsilon_accessible: each state of the result has its epsilon transitions followed once
+     */
+    bitset epsilon_accessible(bitset from) const;
+
+    /**
+     * \fn bitset reachable(bitset from) const
+     * \brief Gets the states reachable from some state in from, following any number of transitions of any label
+     */
+    bitset reachable(bitset from) const;
+
+    /**
+     * \fn std::vector<int> epsilon_components(std::vector<int>* finished = nullptr) const
+     * \brief Gets the strongly connected components of the graph of the epsilon transitions
+     * \param finished if not null, receives all the states, component by component, in the order in which the components
+     *        are completed: each component comes after all the components epsilon-accessible from it
+     * \return a vector r of size state_count(), such that r[q] is the smallest state of the component of q
+     *
+     * All the states of a component are epsilon-accessible from each other, so they can be merged into r[q]
+     * without changing the language. The components are computed by Tarjan's algorithm, in O(|transitions|),
+     * with an explicit stack instead of recursion, since the epsilon chains of regular expressions can be long.
+     */
+    std::vector<int> epsilon_components(std::vector<int>* finished = nullptr) const;
+  };
+
+}
+
+#endif // TRANSITION_INDEX_HPP_DEFINED